@@ -398,10 +398,220 @@ int QueuingAudioStreamImpl::readBuffer(int16 *buffer, const int numSamples) {
 	return samplesDecoded;
 }
 
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+#define ENABLE_LOCKFREE_QUEUING_STREAM
+
+// Full memory barrier, which also keeps the compiler from reordering
+#define QUEUE_MEMORY_BARRIER() __sync_synchronize()
+
+/**
+ * A QueuingAudioStream which does not take any lock, for the common case
+ * of a single thread queuing streams while the mixer thread reads them.
+ *
+ * The queued streams are kept in fixed size segments of slots, which are
+ * linked as needed. The producer only ever writes _writeCount and the
+ * link to a new segment, the consumer only ever writes _readCount, so a
+ * memory barrier before publishing each of these is all the
+ * synchronization needed. A segment which has been read completely is
+ * handed back to the producer through _spareSegment, so that a stream
+ * which is fed at a steady pace does not allocate new segments. This only
+ * covers the slots: queueBuffer() still creates a raw stream per buffer.
+ */
+class LockFreeQueuingAudioStream : public QueuingAudioStream {
+private:
+	struct StreamHolder {
+		AudioStream *_stream;
+		DisposeAfterUse::Flag _disposeAfterUse;
+	};
+
+	struct Segment {
+		StreamHolder *_slots;
+		Segment *volatile _next;
+
+		Segment(uint size) : _slots(new StreamHolder[size]), _next(0) {}
+		~Segment() { delete[] _slots; }
+	};
+
+	const int _rate;
+	const bool _stereo;
+	const uint _segmentSize;
+
+	/** Set by finish(), after all streams have been queued. */
+	volatile bool _finished;
+
+	/** Number of streams queued and read so far. */
+	volatile uint32 _writeCount;
+	volatile uint32 _readCount;
+
+	/** Segment and slot the producer writes to next. */
+	Segment *_writeSegment;
+	uint _writePos;
+
+	/**
+	 * Segment and slot the consumer reads from next. Moving to the next
+	 * segment is left to front(), which endOfData() needs as well.
+	 */
+	mutable Segment *_readSegment;
+	mutable uint _readPos;
+
+	/**
+	 * A segment the consumer is done with. Only the consumer sets it,
+	 * and only when it is 0; only the producer takes it and resets it.
+	 */
+	mutable Segment *volatile _spareSegment;
+
+	StreamHolder *front() const;
+	void popFront();
+
+public:
+	LockFreeQueuingAudioStream(int rate, bool stereo, uint segmentSize);
+	~LockFreeQueuingAudioStream();
+
+	// Implement the AudioStream API
+	virtual int readBuffer(int16 *buffer, const int numSamples);
+	virtual bool isStereo() const { return _stereo; }
+	virtual int getRate() const { return _rate; }
+
+	virtual bool endOfData() const {
+		StreamHolder *holder = front();
+		return !holder || holder->_stream->endOfData();
+	}
+
+	virtual bool endOfStream() const {
+		if (!_finished)
+			return false;
+		// Everything queued before finish() is visible now
+		QUEUE_MEMORY_BARRIER();
+		return _readCount == _writeCount;
+	}
+
+	// Implement the QueuingAudioStream API
+	virtual void queueAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+	virtual void finish() {
+		QUEUE_MEMORY_BARRIER();
+		_finished = true;
+	}
+
+	uint32 numQueuedStreams() const {
+		return _writeCount - _readCount;
+	}
+};
+
+LockFreeQueuingAudioStream::LockFreeQueuingAudioStream(int rate, bool stereo, uint segmentSize)
+    : _rate(rate), _stereo(stereo), _segmentSize(MAX<uint>(segmentSize, 1)), _finished(false),
+      _writeCount(0), _readCount(0), _writePos(0), _readPos(0), _spareSegment(0) {
+	_writeSegment = _readSegment = new Segment(_segmentSize);
+}
+
+LockFreeQueuingAudioStream::~LockFreeQueuingAudioStream() {
+	StreamHolder *holder;
+	while ((holder = front()) != 0) {
+		if (holder->_disposeAfterUse == DisposeAfterUse::YES)
+			delete holder->_stream;
+		popFront();
+	}
+
+	delete _readSegment;
+	delete _spareSegment;
+}
+
+void LockFreeQueuingAudioStream::queueAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	assert(!_finished);
+	if ((stream->getRate() != getRate()) || (stream->isStereo() != isStereo()))
+		error("LockFreeQueuingAudioStream::queueAudioStream: stream has mismatched parameters");
+
+	if (_writePos == _segmentSize) {
+		Segment *segment = _spareSegment;
+		if (segment) {
+			_spareSegment = 0;
+			segment->_next = 0;
+		} else {
+			segment = new Segment(_segmentSize);
+		}
+
+		// The consumer only follows the link once the first slot of
+		// the new segment is published below
+		_writeSegment->_next = segment;
+		_writeSegment = segment;
+		_writePos = 0;
+	}
+
+	StreamHolder &holder = _writeSegment->_slots[_writePos++];
+	holder._stream = stream;
+	holder._disposeAfterUse = disposeAfterUse;
+
+	QUEUE_MEMORY_BARRIER();
+	_writeCount = _writeCount + 1;
+}
+
+LockFreeQueuingAudioStream::StreamHolder *LockFreeQueuingAudioStream::front() const {
+	if (_readCount == _writeCount)
+		return 0;
+	// Do not read the slot before it is known to be published
+	QUEUE_MEMORY_BARRIER();
+
+	if (_readPos == _segmentSize) {
+		Segment *segment = _readSegment;
+		_readSegment = segment->_next;
+		_readPos = 0;
+
+		QUEUE_MEMORY_BARRIER();
+		if (!_spareSegment)
+			_spareSegment = segment;
+		else
+			delete segment;
+	}
+
+	return &_readSegment->_slots[_readPos];
+}
+
+void LockFreeQueuingAudioStream::popFront() {
+	++_readPos;
+
+	// Done with the slot before the producer may reuse its segment
+	QUEUE_MEMORY_BARRIER();
+	_readCount = _readCount + 1;
+}
+
+int LockFreeQueuingAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samplesDecoded = 0;
+	StreamHolder *holder;
+
+	while (samplesDecoded < numSamples && (holder = front()) != 0) {
+		AudioStream *stream = holder->_stream;
+		samplesDecoded += stream->readBuffer(buffer + samplesDecoded, numSamples - samplesDecoded);
+
+		// Done with the stream completely
+		if (stream->endOfStream()) {
+			if (holder->_disposeAfterUse == DisposeAfterUse::YES)
+				delete stream;
+			popFront();
+			continue;
+		}
+
+		// Done with data but not the stream, bail out
+		if (stream->endOfData())
+			break;
+	}
+
+	return samplesDecoded;
+}
+
+#endif
+
 QueuingAudioStream *makeQueuingAudioStream(int rate, bool stereo) {
 	return new QueuingAudioStreamImpl(rate, stereo);
 }
 
+QueuingAudioStream *makeLockFreeQueuingAudioStream(int rate, bool stereo, uint segmentSize) {
+#ifdef ENABLE_LOCKFREE_QUEUING_STREAM
+	return new LockFreeQueuingAudioStream(rate, stereo, segmentSize);
+#else
+	return new QueuingAudioStreamImpl(rate, stereo);
+#endif
+}
+
 Timestamp convertTimeToStreamPos(const Timestamp &where, int rate, bool isStereo) {
 	Timestamp result(where.convertToFramerate(rate * (isStereo ? 2 : 1)));
 
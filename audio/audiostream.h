@@ -351,6 +351,21 @@ public:
  */
 QueuingAudioStream *makeQueuingAudioStream(int rate, bool stereo);
 
+/**
+ * Factory function for a QueuingAudioStream which does not take any lock,
+ * for streams fed by a single thread at a time, e.g. a movie player
+ * queuing a buffer per frame. Reading it, i.e. playing it, must happen on
+ * one thread too, which the mixer guarantees. Neither side has to wait
+ * for the other, so the mixer is never held up by the thread queuing.
+ *
+ * Streams are kept in segments of segmentSize slots. For a stream which is
+ * fed at a steady pace the segments are recycled once two have been used;
+ * queueBuffer() still allocates a stream for every buffer queued.
+ * Falls back to makeQueuingAudioStream() where memory barriers are not
+ * available.
+ */
+QueuingAudioStream *makeLockFreeQueuingAudioStream(int rate, bool stereo, uint segmentSize = 32);
+
 /**
  * Converts a point in time to a precise sample offset
  * with the given parameters.
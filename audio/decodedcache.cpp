@@ -0,0 +1,277 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/decodedcache.h"
+#include "audio/audiostream.h"
+
+#include "common/array.h"
+#include "common/debug.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+namespace Common {
+DECLARE_SINGLETON(Audio::DecodedAudioCache);
+}
+
+namespace Audio {
+
+enum {
+	kDefaultBudget = 4 * 1024 * 1024,
+	kDefaultMaxClipSize = 256 * 1024
+};
+
+/**
+ * A stream over a cached clip, which keeps the clip alive.
+ */
+class CachedClipStream : public SeekableAudioStream {
+public:
+	CachedClipStream(DecodedAudioCache *cache, DecodedAudioCache::Clip *clip) : _cache(cache), _clip(clip), _pos(0) {}
+	~CachedClipStream() { _cache->releaseClip(_clip); }
+
+	int readBuffer(int16 *buffer, const int numSamples) {
+		const int samples = MIN<uint32>(numSamples, _clip->sampleCount - _pos);
+		memcpy(buffer, _clip->samples + _pos, samples * sizeof(int16));
+		_pos += samples;
+		return samples;
+	}
+
+	bool isStereo() const { return _clip->stereo; }
+	int getRate() const { return _clip->rate; }
+	bool endOfData() const { return _pos >= _clip->sampleCount; }
+
+	bool seek(const Timestamp &where) {
+		const uint32 frame = convertTimeToStreamPos(where, getRate(), isStereo()).totalNumberOfFrames();
+		_pos = frame * (isStereo() ? 2 : 1);
+		if (_pos > _clip->sampleCount) {
+			_pos = _clip->sampleCount;
+			return false;
+		}
+		return true;
+	}
+
+	Timestamp getLength() const { return Timestamp(0, _clip->sampleCount / (isStereo() ? 2 : 1), getRate()); }
+
+private:
+	DecodedAudioCache *_cache;
+	DecodedAudioCache::Clip *_clip;
+	uint32 _pos;
+};
+
+DecodedAudioCache::DecodedAudioCache() : _useCounter(0), _budget(kDefaultBudget), _maxClipSize(kDefaultMaxClipSize) {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+DecodedAudioCache::~DecodedAudioCache() {
+	clear();
+	debug(1, "DecodedAudioCache: %d hits, %d misses, %d rejected, %d evictions",
+	      _stats.hits, _stats.misses, _stats.rejected, _stats.evictions);
+}
+
+Common::String DecodedAudioCache::makeKey(const Common::String &resource, const char *codec, int rate) {
+	return Common::String::format("%s|%s|%d", resource.c_str(), codec, rate);
+}
+
+void DecodedAudioCache::setLimits(uint32 budget, uint32 maxClipSize) {
+	Common::StackLock lock(_mutex);
+
+	_budget = budget;
+	_maxClipSize = maxClipSize;
+
+	// Clips rejected before may fit now
+	_rejected.clear();
+
+	// Drop the clips which are not allowed anymore
+	Common::Array<Common::String> tooLarge;
+	for (ClipMap::iterator i = _clips.begin(); i != _clips.end(); ++i) {
+		if (i->_value->sampleCount * sizeof(int16) > _maxClipSize)
+			tooLarge.push_back(i->_key);
+	}
+	for (uint i = 0; i < tooLarge.size(); ++i)
+		evict(_clips.find(tooLarge[i]));
+
+	while (_stats.bytes > _budget)
+		evictOldest();
+}
+
+SeekableAudioStream *DecodedAudioCache::find(const Common::String &key, bool *rejected) {
+	Common::StackLock lock(_mutex);
+
+	if (rejected)
+		*rejected = _rejected.contains(key);
+
+	ClipMap::iterator i = _clips.find(key);
+	if (i == _clips.end()) {
+		_stats.misses++;
+		return 0;
+	}
+
+	_stats.hits++;
+	i->_value->lastUse = ++_useCounter;
+	return makeClipStream(i->_value);
+}
+
+SeekableAudioStream *DecodedAudioCache::insert(const Common::String &key, SeekableAudioStream *stream) {
+	if (!stream)
+		return 0;
+
+	uint32 maxClipSize;
+	{
+		Common::StackLock lock(_mutex);
+		if (_rejected.contains(key)) {
+			_stats.rejected++;
+			return stream;
+		}
+		maxClipSize = _maxClipSize;
+	}
+
+	// Streams which know their length do not need to be decoded to find
+	// out they are too large
+	const uint32 maxSamples = maxClipSize / sizeof(int16);
+	const uint32 length = stream->getLength().totalNumberOfFrames() * (stream->isStereo() ? 2 : 1);
+	if (length > maxSamples)
+		return reject(key, stream);
+
+	// Decode without holding the lock, giving up as soon as the clip
+	// turns out to be too large. Reads are a multiple of four samples,
+	// which some decoders need.
+	const int chunkSamples = 2048;
+	uint32 capacity = 0;
+	uint32 count = 0;
+	int16 *samples = 0;
+
+	while (count <= maxSamples) {
+		if (capacity - count < (uint32)chunkSamples) {
+			capacity = MAX<uint32>(capacity * 2, 4 * chunkSamples);
+			int16 *newSamples = (int16 *)realloc(samples, capacity * sizeof(int16));
+			if (!newSamples) {
+				warning("DecodedAudioCache: Could not allocate %u bytes for '%s'", (uint)(capacity * sizeof(int16)), key.c_str());
+				free(samples);
+				stream->rewind();
+				return reject(key, stream);
+			}
+			samples = newSamples;
+		}
+
+		const int read = stream->readBuffer(samples + count, chunkSamples);
+		if (read <= 0)
+			break;
+		count += read;
+	}
+
+	if (count > maxSamples || !stream->endOfData()) {
+		free(samples);
+		stream->rewind();
+		return reject(key, stream);
+	}
+
+	Clip *clip = new Clip;
+	clip->samples = samples;
+	clip->sampleCount = count;
+	clip->rate = stream->getRate();
+	clip->stereo = stream->isStereo();
+	clip->refCount = 1;
+	delete stream;
+
+	Common::StackLock lock(_mutex);
+
+	// Another thread may have cached the same clip meanwhile
+	ClipMap::iterator i = _clips.find(key);
+	if (i != _clips.end())
+		evict(i);
+
+	const uint32 size = count * sizeof(int16);
+	while (!_clips.empty() && _stats.bytes + size > _budget)
+		evictOldest();
+
+	clip->lastUse = ++_useCounter;
+	_clips[key] = clip;
+	_stats.clips++;
+	_stats.bytes += size;
+
+	return makeClipStream(clip);
+}
+
+void DecodedAudioCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	while (!_clips.empty())
+		evict(_clips.begin());
+
+	_rejected.clear();
+}
+
+DecodedAudioCache::Stats DecodedAudioCache::getStats() {
+	Common::StackLock lock(_mutex);
+	return _stats;
+}
+
+SeekableAudioStream *DecodedAudioCache::reject(const Common::String &key, SeekableAudioStream *stream) {
+	Common::StackLock lock(_mutex);
+
+	_rejected[key] = true;
+	_stats.rejected++;
+	return stream;
+}
+
+SeekableAudioStream *DecodedAudioCache::makeClipStream(Clip *clip) {
+	// Called with the mutex held
+	clip->refCount++;
+	return new CachedClipStream(this, clip);
+}
+
+void DecodedAudioCache::evictOldest() {
+	// Called with the mutex held. There are few clips, so a search
+	// is cheaper than keeping them sorted by their use.
+	ClipMap::iterator oldest = _clips.begin();
+	for (ClipMap::iterator i = _clips.begin(); i != _clips.end(); ++i) {
+		if (i->_value->lastUse < oldest->_value->lastUse)
+			oldest = i;
+	}
+
+	_stats.evictions++;
+	evict(oldest);
+}
+
+void DecodedAudioCache::evict(ClipMap::iterator i) {
+	// Called with the mutex held
+	Clip *clip = i->_value;
+	_clips.erase(i);
+
+	_stats.clips--;
+	_stats.bytes -= clip->sampleCount * sizeof(int16);
+
+	if (--clip->refCount == 0) {
+		free(clip->samples);
+		delete clip;
+	}
+}
+
+void DecodedAudioCache::releaseClip(Clip *clip) {
+	Common::StackLock lock(_mutex);
+
+	if (--clip->refCount == 0) {
+		free(clip->samples);
+		delete clip;
+	}
+}
+
+} // End of namespace Audio
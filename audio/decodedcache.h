@@ -0,0 +1,147 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef AUDIO_DECODEDCACHE_H
+#define AUDIO_DECODEDCACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Audio {
+
+class SeekableAudioStream;
+
+/**
+ * Cache of decoded short clips, shared by all engines.
+ *
+ * Engines usually create a new stream over the same resource every time
+ * a sound effect is played, which means decoding compressed data again
+ * and again. Instead, they can look the clip up here first:
+ *
+ * @code
+ * bool rejected;
+ * Audio::SeekableAudioStream *stream = DecodedAudioCacheMan.find(key, &rejected);
+ * if (!stream && rejected)
+ *     stream = Audio::makeVorbisStream(...);
+ * else if (!stream)
+ *     stream = DecodedAudioCacheMan.insert(key, Audio::makeVorbisStream(...));
+ * @endcode
+ *
+ * The streams returned share the decoded data, which stays alive as long
+ * as any of them does, even after the clip is evicted. Clips are evicted
+ * in least recently used order once the cache exceeds its byte budget.
+ *
+ * The cache may be used from any thread. It must only be destroyed when
+ * no stream over a cached clip is left, i.e. after the engine has
+ * stopped all its sounds.
+ */
+class DecodedAudioCache : public Common::Singleton<DecodedAudioCache> {
+public:
+	struct Stats {
+		uint32 hits;      ///< Lookups which found the clip
+		uint32 misses;    ///< Lookups which did not find the clip
+		uint32 rejected;  ///< Clips which were too large to be cached
+		uint32 evictions; ///< Clips evicted to stay within the budget
+		uint32 clips;     ///< Clips currently cached
+		uint32 bytes;     ///< Size of the decoded data currently cached
+	};
+
+	/**
+	 * Builds a cache key from the resource a clip comes from, its codec
+	 * and its rate. The resource should be unique within the game, e.g.
+	 * an archive member name or a resource type and id.
+	 */
+	static Common::String makeKey(const Common::String &resource, const char *codec, int rate = 0);
+
+	/**
+	 * Sets the byte budget of the cache, and the largest size of the
+	 * decoded data of a clip to be cached. Clips are evicted as needed.
+	 */
+	void setLimits(uint32 budget, uint32 maxClipSize);
+
+	/**
+	 * Looks up a clip.
+	 *
+	 * @param rejected  if given, set to whether insert() rejected the clip
+	 *                  before, in which case it is not worth inserting again
+	 * @return a new stream over the decoded clip, or 0 if it is not cached
+	 */
+	SeekableAudioStream *find(const Common::String &key, bool *rejected = 0);
+
+	/**
+	 * Decodes a clip and caches it, unless it is too large. Takes over
+	 * the given stream. Clips whose length shows they are too large are
+	 * rejected without decoding anything.
+	 *
+	 * @return a new stream over the decoded clip, or the given stream
+	 *         rewound if it was not cached
+	 */
+	SeekableAudioStream *insert(const Common::String &key, SeekableAudioStream *stream);
+
+	/** Evicts all clips and forgets which clips were rejected. */
+	void clear();
+
+	Stats getStats();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	friend class CachedClipStream;
+
+	struct Clip {
+		int16 *samples;
+		uint32 sampleCount;
+		int rate;
+		bool stereo;
+		int refCount;    ///< Streams using the clip, plus one while it is cached
+		uint32 lastUse;  ///< Value of _useCounter when the clip was last used
+	};
+
+	typedef Common::HashMap<Common::String, Clip *> ClipMap;
+	typedef Common::HashMap<Common::String, bool> RejectedMap;
+
+	DecodedAudioCache();
+	~DecodedAudioCache();
+
+	SeekableAudioStream *makeClipStream(Clip *clip);
+	SeekableAudioStream *reject(const Common::String &key, SeekableAudioStream *stream);
+	void evictOldest();
+	void evict(ClipMap::iterator i);
+	void releaseClip(Clip *clip);
+
+	Common::Mutex _mutex;
+	ClipMap _clips;
+	RejectedMap _rejected;
+	uint32 _useCounter;
+	uint32 _budget;
+	uint32 _maxClipSize;
+	Stats _stats;
+};
+
+} // End of namespace Audio
+
+/** Convenience shortcut for accessing the decoded audio cache. */
+#define DecodedAudioCacheMan Audio::DecodedAudioCache::instance()
+
+#endif
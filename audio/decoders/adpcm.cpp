@@ -56,6 +56,18 @@ void ADPCMStream::reset() {
 	_blockPos[0] = _blockPos[1] = _blockAlign; // To make sure first header is read
 }
 
+/**
+ * Reads a block of data at once. If the stream ends early, the rest of
+ * the block is filled with zeros, like reading past the end of the
+ * stream byte by byte gives.
+ */
+uint32 ADPCMStream::readBlock(byte *data, uint32 size) {
+	const uint32 read = _stream->read(data, size);
+	if (read < size)
+		memset(data + read, 0, size - read);
+	return read;
+}
+
 bool ADPCMStream::rewind() {
 	// TODO: Error checking.
 	reset();
@@ -209,43 +221,77 @@ int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 #pragma mark -
 
 
-int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	// Need to write at least one sample per channel
-	assert((numSamples % _channels) == 0);
+// Same as Ima_ADPCMStream::decodeIMA, for block decoders which keep the
+// channel status in local variables
+static inline int16 decodeIMANibble(byte code, int32 &last, int32 &stepIndex) {
+	int32 E = (2 * (code & 0x7) + 1) * Ima_ADPCMStream::_imaTable[stepIndex] / 8;
+	int32 diff = (code & 0x08) ? -E : E;
+	last = CLIP<int32>(last + diff, -32768, 32767);
+	stepIndex = CLIP<int32>(stepIndex + ADPCMStream::_stepAdjustTable[code], 0, ARRAYSIZE(Ima_ADPCMStream::_imaTable) - 1);
 
-	int samples = 0;
+	return last;
+}
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if (_blockPos[0] == _blockAlign) {
-			for (int i = 0; i < _channels; i++) {
-				// read block header
-				_status.ima_ch[i].last = _stream->readSint16LE();
-				_status.ima_ch[i].stepIndex = _stream->readSint16LE();
-			}
+void MSIma_ADPCMStream::decodeBlock() {
+	const uint32 headerSize = _channels * 4;
+	const uint32 chunkSize = _channels * 4;
+
+	// The block is made of chunks of four bytes per channel following
+	// the header. A chunk is always decoded completely, and the header
+	// is always followed by one, even past the end of the data.
+	const uint32 dataSize = MIN<uint32>(_blockAlign, _endpos - _stream->pos());
+	uint32 chunks = 1;
+	if (dataSize > headerSize)
+		chunks = (dataSize - headerSize + chunkSize - 1) / chunkSize;
+	const uint32 size = headerSize + chunks * chunkSize;
+
+	const uint32 read = readBlock(_blockData, size);
+	if (read < size) {
+		// The stream ended early, the chunk it ended in is the last one
+		chunks = 1;
+		if (read > headerSize)
+			chunks += (read - headerSize) / chunkSize;
+	}
 
-			_blockPos[0] = _channels * 4;
-		}
+	for (int i = 0; i < _channels; i++) {
+		int32 last = (int16)READ_LE_UINT16(_blockData + i * 4);
+		int32 stepIndex = (int16)READ_LE_UINT16(_blockData + i * 4 + 2);
 
-		// Decode a set of samples
-		for (int i = 0; i < _channels; i++) {
-			// The stream encodes four bytes per channel at a time
+		const byte *data = _blockData + headerSize + i * 4;
+		int16 *samples = _blockSamples + i;
+		for (uint32 chunk = 0; chunk < chunks; chunk++, data += chunkSize) {
 			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
+				samples[0] = decodeIMANibble(data[j] & 0x0f, last, stepIndex);
+				samples[_channels] = decodeIMANibble((data[j] >> 4) & 0x0f, last, stepIndex);
+				samples += _channels * 2;
 			}
 		}
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
-			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
-			}
+		_status.ima_ch[i].last = last;
+		_status.ima_ch[i].stepIndex = stepIndex;
+	}
+
+	_blockSampleCount = chunks * 8 * _channels;
+	_blockSamplePos = 0;
+}
 
-			samples += _channels;
+int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	// Need to write at least one sample per channel
+	assert((numSamples % _channels) == 0);
+
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSampleCount) {
+			if (_stream->eos() || _stream->pos() >= _endpos)
+				break;
+			decodeBlock();
 		}
+
+		const int count = MIN<int>(numSamples - samples, _blockSampleCount - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -286,46 +332,66 @@ int16 MS_ADPCMStream::decodeMS(ADPCMChannelStatus *c, byte code) {
 	return (int16)predictor;
 }
 
-int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+void MS_ADPCMStream::decodeBlock() {
+	const uint32 headerSize = _channels * 7;
+
+	// The header is read completely, even past the end of the data
+	const uint32 size = MAX<uint32>(headerSize, MIN<uint32>(_blockAlign, _endpos - _stream->pos()));
+	const uint32 read = readBlock(_blockData, size);
+
+	// If the stream ends early, one zero byte past its end is decoded
+	uint32 dataSize = size - headerSize;
+	if (read < size)
+		dataSize = (read >= headerSize) ? read - headerSize + 1 : 0;
+
+	const byte *data = _blockData;
+	int16 *samples = _blockSamples;
 	int i;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			if (_blockPos[0] == _blockAlign) {
-				// read block header
-				for (i = 0; i < _channels; i++) {
-					_status.ch[i].predictor = CLIP(_stream->readByte(), (byte)0, (byte)6);
-					_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
-					_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
-				}
-
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].delta = _stream->readSint16LE();
-
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].sample1 = _stream->readSint16LE();
-
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample2 = _stream->readSint16LE();
-
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
-
-				_blockPos[0] = _channels * 7;
-			} else {
-				data = _stream->readByte();
-				_blockPos[0]++;
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[0], (data >> 4) & 0x0f);
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[_channels - 1], data & 0x0f);
-			}
-			_decodedSampleIndex = 0;
+	// read block header
+	for (i = 0; i < _channels; i++) {
+		_status.ch[i].predictor = CLIP(*data++, (byte)0, (byte)6);
+		_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
+		_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
+	}
+
+	for (i = 0; i < _channels; i++, data += 2)
+		_status.ch[i].delta = READ_LE_UINT16(data);
+
+	for (i = 0; i < _channels; i++, data += 2)
+		_status.ch[i].sample1 = READ_LE_UINT16(data);
+
+	for (i = 0; i < _channels; i++, data += 2)
+		*samples++ = _status.ch[i].sample2 = READ_LE_UINT16(data);
+
+	for (i = 0; i < _channels; i++)
+		*samples++ = _status.ch[i].sample1;
+
+	ADPCMChannelStatus *left = &_status.ch[0];
+	ADPCMChannelStatus *right = &_status.ch[_channels - 1];
+	for (uint32 j = 0; j < dataSize; j++) {
+		*samples++ = decodeMS(left, (data[j] >> 4) & 0x0f);
+		*samples++ = decodeMS(right, data[j] & 0x0f);
+	}
+
+	_blockSampleCount = samples - _blockSamples;
+	_blockSamplePos = 0;
+}
+
+int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSampleCount) {
+			if (_stream->eos() || _stream->pos() >= _endpos)
+				break;
+			decodeBlock();
 		}
 
-		// _decodedSamples acts as a FIFO of depth 2 or 4;
-		buffer[samples] = _decodedSamples[_decodedSampleIndex++];
-		_decodedSampleCount--;
+		const int count = MIN<int>(numSamples - samples, _blockSampleCount - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -337,59 +403,114 @@ int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 
 #define DK3_READ_NIBBLE() \
 do { \
-	if (_topNibble) { \
-		_nibble = _lastByte >> 4; \
-		_topNibble = false; \
+	if (topNibble) { \
+		nibble = lastByte >> 4; \
+		topNibble = false; \
 	} else { \
-		if (_stream->pos() >= _endpos) \
+		if (pos >= _endpos) \
 			break; \
-		if ((_stream->pos() % _blockAlign) == 0) \
+		if ((pos % _blockAlign) == 0) \
 			continue; \
-		_lastByte = _stream->readByte(); \
-		_nibble = _lastByte & 0xf; \
-		_topNibble = true; \
+		if (pos - start < (int32)read) { \
+			lastByte = _blockData[pos - start]; \
+			pos++; \
+		} else { \
+			lastByte = 0; \
+			eos = true; \
+		} \
+		nibble = lastByte & 0xf; \
+		topNibble = true; \
 	} \
 } while (0)
 
 
-int DK3_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples = 0;
+void DK3_ADPCMStream::decodeBlock() {
+	const int32 start = _stream->pos();
+	const bool atBlockStart = (start % _blockAlign) == 0;
 
-	assert((numSamples % 4) == 0);
+	// Decode up to the next block; the header is read completely,
+	// even past the end of the data
+	uint32 size = MIN<uint32>(_blockAlign - start % _blockAlign, _endpos - start);
+	if (atBlockStart)
+		size = MAX<uint32>(size, 16);
+	const uint32 read = readBlock(_blockData, size);
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if ((_stream->pos() % _blockAlign) == 0) {
-			_stream->readUint16LE(); // Unknown
-			uint16 rate = _stream->readUint16LE(); // Copy of rate
-			_stream->skip(6); // Unknown
-			// Get predictor for both sum/diff channels
-			_status.ima_ch[0].last = _stream->readSint16LE();
-			_status.ima_ch[1].last = _stream->readSint16LE();
-			// Get index for both sum/diff channels
-			_status.ima_ch[0].stepIndex = _stream->readByte();
-			_status.ima_ch[1].stepIndex = _stream->readByte();
-
-			if (_stream->eos())
-				break;
+	_blockSampleCount = 0;
+	_blockSamplePos = 0;
 
-			// Sanity check
-			assert(rate == getRate());
-		}
+	// Position of the stream if it was read byte by byte
+	int32 pos = start;
+	bool eos = false;
+
+	if (atBlockStart) {
+		if (read < 16)
+			return;
+
+		// Bytes 0-1 and 4-9 are unknown
+		uint16 rate = READ_LE_UINT16(_blockData + 2); // Copy of rate
+		// Get predictor for both sum/diff channels
+		_status.ima_ch[0].last = (int16)READ_LE_UINT16(_blockData + 10);
+		_status.ima_ch[1].last = (int16)READ_LE_UINT16(_blockData + 12);
+		// Get index for both sum/diff channels
+		_status.ima_ch[0].stepIndex = _blockData[14];
+		_status.ima_ch[1].stepIndex = _blockData[15];
+
+		// Sanity check
+		assert(rate == getRate());
 
+		pos += 16;
+	}
+
+	int32 sumLast = _status.ima_ch[0].last, sumStepIndex = _status.ima_ch[0].stepIndex;
+	int32 diffLast = _status.ima_ch[1].last, diffStepIndex = _status.ima_ch[1].stepIndex;
+	byte nibble = _nibble, lastByte = _lastByte;
+	bool topNibble = _topNibble;
+	int16 *samples = _blockSamples;
+
+	while (!eos && pos < _endpos && (pos % _blockAlign) != 0) {
 		DK3_READ_NIBBLE();
-		decodeIMA(_nibble, 0);
+		decodeIMANibble(nibble, sumLast, sumStepIndex);
 
 		DK3_READ_NIBBLE();
-		decodeIMA(_nibble, 1);
+		decodeIMANibble(nibble, diffLast, diffStepIndex);
 
-		buffer[samples++] = _status.ima_ch[0].last + _status.ima_ch[1].last;
-		buffer[samples++] = _status.ima_ch[0].last - _status.ima_ch[1].last;
+		*samples++ = sumLast + diffLast;
+		*samples++ = sumLast - diffLast;
 
 		DK3_READ_NIBBLE();
-		decodeIMA(_nibble, 0);
+		decodeIMANibble(nibble, sumLast, sumStepIndex);
 
-		buffer[samples++] = _status.ima_ch[0].last + _status.ima_ch[1].last;
-		buffer[samples++] = _status.ima_ch[0].last - _status.ima_ch[1].last;
+		*samples++ = sumLast + diffLast;
+		*samples++ = sumLast - diffLast;
+	}
+
+	_status.ima_ch[0].last = sumLast;
+	_status.ima_ch[0].stepIndex = sumStepIndex;
+	_status.ima_ch[1].last = diffLast;
+	_status.ima_ch[1].stepIndex = diffStepIndex;
+	_nibble = nibble;
+	_lastByte = lastByte;
+	_topNibble = topNibble;
+
+	_blockSampleCount = samples - _blockSamples;
+}
+
+int DK3_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	assert((numSamples % 4) == 0);
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSampleCount) {
+			if (_stream->eos() || _stream->pos() >= _endpos)
+				break;
+			decodeBlock();
+		}
+
+		const int count = MIN<int>(numSamples - samples, _blockSampleCount - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -423,15 +544,7 @@ const int16 Ima_ADPCMStream::_imaTable[89] = {
 };
 
 int16 Ima_ADPCMStream::decodeIMA(byte code, int channel) {
-	int32 E = (2 * (code & 0x7) + 1) * _imaTable[_status.ima_ch[channel].stepIndex] / 8;
-	int32 diff = (code & 0x08) ? -E : E;
-	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + diff, -32768, 32767);
-
-	_status.ima_ch[channel].last = samp;
-	_status.ima_ch[channel].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[channel].stepIndex = CLIP<int32>(_status.ima_ch[channel].stepIndex, 0, ARRAYSIZE(_imaTable) - 1);
-
-	return samp;
+	return decodeIMANibble(code, _status.ima_ch[channel].last, _status.ima_ch[channel].stepIndex);
 }
 
 SeekableAudioStream *makeADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
@@ -59,6 +59,8 @@ protected:
 
 	virtual void reset();
 
+	uint32 readBlock(byte *data, uint32 size);
+
 public:
 	ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign);
 
@@ -164,21 +166,36 @@ public:
 		if (blockAlign % (_channels * 4))
 			error("MSIma_ADPCMStream(): invalid blockAlign");
 
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		// A header is always followed by at least one chunk of data
+		const uint32 maxBlockSize = MAX<uint32>(blockAlign, _channels * 8);
+		_blockData = new byte[maxBlockSize];
+		_blockSamples = new int16[maxBlockSize * 2];
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
+	}
+
+	~MSIma_ADPCMStream() {
+		delete[] _blockData;
+		delete[] _blockSamples;
 	}
 
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_blockSamplePos == _blockSampleCount); }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 	void reset() {
 		Ima_ADPCMStream::reset();
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
 	}
 
 private:
-	int16 _buffer[2][8];
-	int _samplesLeft[2];
+	void decodeBlock();
+
+	byte *_blockData;
+	int16 *_blockSamples;     ///< Decoded samples of the current block, interleaved
+	uint32 _blockSampleCount;
+	uint32 _blockSamplePos;
 };
 
 class MS_ADPCMStream : public ADPCMStream {
@@ -200,6 +217,8 @@ protected:
 	void reset() {
 		ADPCMStream::reset();
 		memset(&_status, 0, sizeof(_status));
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
 	}
 
 public:
@@ -208,11 +227,21 @@ public:
 		if (blockAlign == 0)
 			error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
 		memset(&_status, 0, sizeof(_status));
-		_decodedSampleCount = 0;
-		_decodedSampleIndex = 0;
+
+		// The header is read even if the block is shorter
+		const uint32 maxBlockSize = MAX<uint32>(blockAlign, _channels * 7);
+		_blockData = new byte[maxBlockSize];
+		_blockSamples = new int16[maxBlockSize * 2 + 2];
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
 	}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	~MS_ADPCMStream() {
+		delete[] _blockData;
+		delete[] _blockSamples;
+	}
+
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_blockSamplePos == _blockSampleCount); }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
@@ -220,9 +249,12 @@ protected:
 	int16 decodeMS(ADPCMChannelStatus *c, byte);
 
 private:
-	uint8 _decodedSampleCount;
-	uint8 _decodedSampleIndex;
-	int16 _decodedSamples[4];
+	void decodeBlock();
+
+	byte *_blockData;
+	int16 *_blockSamples;     ///< Decoded samples of the current block, interleaved
+	uint32 _blockSampleCount;
+	uint32 _blockSamplePos;
 };
 
 // Duck DK3 IMA ADPCM Decoder
@@ -234,6 +266,8 @@ protected:
 	void reset() {
 		Ima_ADPCMStream::reset();
 		_topNibble = false;
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
 	}
 
 public:
@@ -243,13 +277,36 @@ public:
 		// DK3 only works as a stereo stream
 		assert(channels == 2);
 		_topNibble = false;
+
+		// The header is read even if the block is shorter. Every three
+		// nibbles, of which a stale one may be used at the end of a block,
+		// give four samples.
+		const uint32 maxBlockSize = MAX<uint32>(blockAlign, 16);
+		_blockData = new byte[maxBlockSize];
+		_blockSamples = new int16[(maxBlockSize * 2 / 3 + 3) * 4];
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
+	}
+
+	~DK3_ADPCMStream() {
+		delete[] _blockData;
+		delete[] _blockSamples;
 	}
 
+	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_blockSamplePos == _blockSampleCount); }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 private:
+	void decodeBlock();
+
 	byte _nibble, _lastByte;
 	bool _topNibble;
+
+	byte *_blockData;
+	int16 *_blockSamples;     ///< Decoded samples of the current block, interleaved
+	uint32 _blockSampleCount;
+	uint32 _blockSamplePos;
 };
 
 } // End of namespace Audio
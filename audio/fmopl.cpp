@@ -23,6 +23,7 @@
 #include "audio/fmopl.h"
 
 #include "audio/mixer.h"
+#include "audio/opl_capture.h"
 #include "audio/softsynth/opl/dosbox.h"
 #include "audio/softsynth/opl/mame.h"
 
@@ -57,6 +58,10 @@ OPL::OPL() {
 	_hasInstance = true;
 }
 
+OPL::OPL(OPL *wrapped) {
+	assert(wrapped);
+}
+
 const Config::EmulatorDescription Config::_drivers[] = {
 	{ "auto", "<default>", kAuto, kFlagOpl2 | kFlagDualOpl2 | kFlagOpl3 },
 	{ "mame", _s("MAME OPL emulator"), kMame, kFlagOpl2 },
@@ -165,30 +170,40 @@ OPL *Config::create(DriverId driver, OplType type) {
 		}
 	}
 
+	OPL *opl = 0;
+
 	switch (driver) {
 	case kMame:
 		if (type == kOpl2)
-			return new MAME::OPL();
+			opl = new MAME::OPL();
 		else
 			warning("MAME OPL emulator only supports OPL2 emulation");
-		return 0;
+		break;
 
 #ifndef DISABLE_DOSBOX_OPL
 	case kDOSBox:
-		return new DOSBox::OPL(type);
+		opl = new DOSBox::OPL(type);
+		break;
 #endif
 
 #ifdef USE_ALSA
 	case kALSA:
-		return ALSA::create(type);
+		opl = ALSA::create(type);
+		break;
 #endif
 
 	default:
 		warning("Unsupported OPL emulator %d", driver);
 		// TODO: Maybe we should add some dummy emulator too, which just outputs
 		// silence as sound?
-		return 0;
+		break;
 	}
+
+	// Record all register writes for devtools/opl_replay when requested
+	if (opl && ConfMan.hasKey("opl_capture"))
+		opl = new CaptureOPL(opl, type, ConfMan.get("opl_capture"));
+
+	return opl;
 }
 
 void OPL::start(TimerCallback *callback, int timerFrequency) {
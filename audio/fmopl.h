@@ -184,6 +184,12 @@ public:
 	};
 
 protected:
+	/**
+	 * Constructor for OPLs which forward to another OPL instance. These don't
+	 * count towards the limit of one OPL output instance.
+	 */
+	explicit OPL(OPL *wrapped);
+
 	/**
 	 * Start the callbacks.
 	 */
@@ -119,6 +119,23 @@ public:
 	 */
 	virtual void sysEx(const byte *msg, uint16 length) { }
 
+	/**
+	 * Output a packed midi command like send(), but let it take effect
+	 * the given number of microseconds into the current timer callback
+	 * period. MIDI parsers use this to pass on the timing of events
+	 * between two timer callbacks.
+	 *
+	 * Drivers which can not place events more precisely than their timer
+	 * callback simply ignore the delay, which is what the default
+	 * implementation does.
+	 */
+	virtual void sendDelayed(uint32 b, uint32 delay) { send(b); }
+
+	/**
+	 * Transmit a sysEx like sysEx(), delayed like sendDelayed().
+	 */
+	virtual void sysExDelayed(const byte *msg, uint16 length, uint32 delay) { sysEx(msg, length); }
+
 	// TODO: Document this.
 	virtual void metaEvent(byte type, byte *data, uint16 length) { }
 };
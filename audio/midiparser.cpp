@@ -38,6 +38,7 @@ _timerRate(0x4A0000),
 _ppqn(96),
 _tempo(500000),
 _psecPerTick(5208), // 500000 / 96
+_eventDelay(0),
 _autoLoop(false),
 _smartJump(false),
 _centerPitchWheelOnUnload(false),
@@ -45,7 +46,9 @@ _sendSustainOffOnNotesOff(false),
 _numTracks(0),
 _activeTrack(255),
 _abortParse(false),
-_jumpingToTick(false) {
+_jumpingToTick(false),
+_buildingSeekIndex(false),
+_seekIndexStopped(false) {
 	memset(_activeNotes, 0, sizeof(_activeNotes));
 	memset(_tracks, 0, sizeof(_tracks));
 	_nextEvent.start = NULL;
@@ -72,7 +75,7 @@ void MidiParser::property(int prop, int value) {
 }
 
 void MidiParser::sendToDriver(uint32 b) {
-	_driver->send(b);
+	_driver->sendDelayed(b, _eventDelay);
 }
 
 void MidiParser::setTempo(uint32 tempo) {
@@ -180,6 +183,7 @@ void MidiParser::onTimer() {
 		for (i = ARRAYSIZE(_hangingNotes); i; --i, ++ptr) {
 			if (ptr->timeLeft) {
 				if (ptr->timeLeft <= _timerRate) {
+					_eventDelay = ptr->timeLeft;
 					sendToDriver(0x80 | ptr->channel, ptr->note, 0);
 					ptr->timeLeft = 0;
 					--_hangingNotesCount;
@@ -197,11 +201,14 @@ void MidiParser::onTimer() {
 		if (eventTime > endTime)
 			break;
 
-		// Process the next info.
+		// Process the next info. Drivers which can do so are told where
+		// in the current period the event belongs.
+		_eventDelay = (eventTime > _position._playTime) ? eventTime - _position._playTime : 0;
 		_position._lastEventTick += info.delta;
 		if (info.event < 0x80) {
 			warning("Bad command or running status %02X", info.event);
 			_position._playPos = 0;
+			_eventDelay = 0;
 			return;
 		}
 
@@ -215,7 +222,11 @@ void MidiParser::onTimer() {
 		}
 
 		// Player::metaEvent() in SCUMM will delete the parser object,
-		// so return immediately if that might have happened.
+		// so return immediately if that might have happened. That is also
+		// why meta events are sent undelayed: _eventDelay cannot be reset
+		// once the parser is gone.
+		if (info.event == 0xFF)
+			_eventDelay = 0;
 		bool ret = processEvent(info);
 		if (!ret)
 			return;
@@ -230,6 +241,9 @@ void MidiParser::onTimer() {
 		_position._playTime = endTime;
 		_position._playTick = (_position._playTime - _position._lastEventTime) / _psecPerTick + _position._lastEventTick;
 	}
+
+	// Anything sent outside of onTimer() takes effect right away
+	_eventDelay = 0;
 }
 
 bool MidiParser::processEvent(const EventInfo &info, bool fireEvents) {
@@ -238,9 +252,9 @@ bool MidiParser::processEvent(const EventInfo &info, bool fireEvents) {
 		// Check for trailing 0xF7 -- if present, remove it.
 		if (fireEvents) {
 			if (info.ext.data[info.length-1] == 0xF7)
-				_driver->sysEx(info.ext.data, (uint16)info.length-1);
+				_driver->sysExDelayed(info.ext.data, (uint16)info.length-1, _eventDelay);
 			else
-				_driver->sysEx(info.ext.data, (uint16)info.length);
+				_driver->sysExDelayed(info.ext.data, (uint16)info.length, _eventDelay);
 		}
 	} else if (info.event == 0xFF) {
 		// META event
@@ -383,6 +397,108 @@ void MidiParser::hangAllActiveNotes() {
 	}
 }
 
+/**
+ * Collects a SeekPoint every kSeekPointInterval events of each track.
+ * Formats whose parseNextEvent has no side effects, or can do without
+ * them while _buildingSeekIndex is set, call this from loadMusic once
+ * the tracks and _ppqn are known. If parseNextEvent sets
+ * _seekIndexStopped, the rest of the track is not indexed.
+ */
+void MidiParser::buildSeekIndex() {
+	static const uint kSeekPointInterval = 32;
+
+	_buildingSeekIndex = true;
+
+	EventInfo info;
+	for (int i = 0; i < _numTracks; ++i) {
+		Common::Array<SeekPoint> &seekPoints = _seekPoints[i];
+		seekPoints.clear();
+
+		resetTracking();
+		_position._playPos = _tracks[i];
+		_seekIndexStopped = false;
+
+		SeekPoint point;
+		point._tempo = 0;
+		point._tempoTick = 0;
+		point._tempoTime = 0;
+		uint32 psecPerTick = 0;
+
+		for (uint count = 0; ; ++count) {
+			if (count % kSeekPointInterval == 0) {
+				point._playPos = _position._playPos;
+				point._lastEventTick = _position._lastEventTick;
+				point._runningStatus = _position._runningStatus;
+				seekPoints.push_back(point);
+			}
+
+			parseNextEvent(info);
+			if (_seekIndexStopped || info.event < 0x80)
+				break;
+
+			_position._lastEventTick += info.delta;
+			if (point._tempo)
+				point._tempoTime += info.delta * psecPerTick;
+
+			if (info.event == 0xFF) {
+				if (info.ext.type == 0x2F)
+					break;
+				if (info.ext.type == 0x51 && info.length >= 3 && _ppqn) {
+					const uint32 tempo = info.ext.data[0] << 16 | info.ext.data[1] << 8 | info.ext.data[2];
+					if (!tempo)
+						break;
+					if (!point._tempo)
+						point._tempoTick = _position._lastEventTick;
+					// Same as setTempo
+					point._tempo = tempo;
+					psecPerTick = (tempo + (_ppqn >> 2)) / _ppqn;
+				}
+			}
+		}
+	}
+
+	_buildingSeekIndex = false;
+	resetTracking();
+}
+
+/**
+ * Moves the position of the active track to the last SeekPoint before
+ * the given tick, as if all events up to there had been processed
+ * without being fired. This is a no-op if the format provides no
+ * seek index.
+ */
+void MidiParser::seekToIndexedTick(uint32 tick) {
+	const Common::Array<SeekPoint> &seekPoints = _seekPoints[_activeTrack];
+
+	// Find the first point whose last event is not before the tick
+	uint first = 0, last = seekPoints.size();
+	while (first < last) {
+		const uint middle = (first + last) / 2;
+		if (seekPoints[middle]._lastEventTick < tick)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+
+	// The first point is the start of the track, nothing to skip then
+	if (first <= 1)
+		return;
+
+	const SeekPoint &point = seekPoints[first - 1];
+	_position._playPos = point._playPos;
+	_position._runningStatus = point._runningStatus;
+	_position._lastEventTick = point._lastEventTick;
+	if (point._tempo) {
+		// Up to the first tempo change the track plays at the current tempo
+		_position._lastEventTime = point._tempoTick * _psecPerTick + point._tempoTime;
+		setTempo(point._tempo);
+	} else {
+		_position._lastEventTime = point._lastEventTick * _psecPerTick;
+	}
+	_position._playTick = _position._lastEventTick;
+	_position._playTime = _position._lastEventTime;
+}
+
 bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool dontSendNoteOn) {
 	if (_activeTrack >= _numTracks)
 		return false;
@@ -395,6 +511,8 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 
 	resetTracking();
 	_position._playPos = _tracks[_activeTrack];
+	if (tick > 0 && !fireEvents)
+		seekToIndexedTick(tick);
 	parseNextEvent(_nextEvent);
 	if (tick > 0) {
 		while (true) {
@@ -453,6 +571,8 @@ bool MidiParser::jumpToTick(uint32 tick, bool fireEvents, bool stopNotes, bool d
 void MidiParser::unloadMusic() {
 	resetTracking();
 	allNotesOff();
+	for (int i = 0; i < _numTracks; ++i)
+		_seekPoints[i].clear();
 	_numTracks = 0;
 	_activeTrack = 255;
 	_abortParse = true;
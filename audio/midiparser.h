@@ -26,6 +26,7 @@
 #define AUDIO_MIDIPARSER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/endian.h"
 
 class MidiDriver_BASE;
@@ -79,6 +80,22 @@ struct Tracker {
 	}
 };
 
+/**
+ * A point within a track from which parsing can be resumed.
+ * SeekPoints are collected when a song is loaded, so that
+ * jumpToTick does not have to parse a track from the start.
+ * The time of the point depends on the tempo the track starts
+ * with, so it is stored relative to the first tempo change.
+ */
+struct SeekPoint {
+	byte * _playPos;        ///< A pointer to the next event to be parsed
+	uint32 _lastEventTick; ///< The tick of the last event before this point
+	byte   _runningStatus;  ///< Cached MIDI command after the last event
+	uint32 _tempo;          ///< The tempo set by the last tempo change before this point, 0 if there is none
+	uint32 _tempoTick;      ///< The tick of the first tempo change before this point
+	uint32 _tempoTime;      ///< The time in microseconds from the first tempo change to the last event
+};
+
 /**
  * Provides comprehensive information on the next event in the MIDI stream.
  * An EventInfo struct is instantiated by format-specific implementations
@@ -274,6 +291,7 @@ protected:
 	uint32 _ppqn;           ///< Pulses Per Quarter Note. (We refer to "pulses" as "ticks".)
 	uint32 _tempo;          ///< Microseconds per quarter note.
 	uint32 _psecPerTick;  ///< Microseconds per tick (_tempo / _ppqn).
+	uint32 _eventDelay;    ///< Offset in microseconds of the event being sent into the current onTimer() period.
 	bool   _autoLoop;       ///< For lightweight clients that don't provide their own flow control.
 	bool   _smartJump;      ///< Support smart expiration of hanging notes when jumping
 	bool   _centerPitchWheelOnUnload;  ///< Center the pitch wheels when unloading a song
@@ -289,6 +307,10 @@ protected:
 	bool   _abortParse;    ///< If a jump or other operation interrupts parsing, flag to abort.
 	bool   _jumpingToTick; ///< True if currently inside jumpToTick
 
+	Common::Array<SeekPoint> _seekPoints[120]; ///< Seek index for each track, see buildSeekIndex.
+	bool   _buildingSeekIndex; ///< True if currently inside buildSeekIndex
+	bool   _seekIndexStopped;  ///< Set by parseNextEvent if the rest of the track cannot be indexed
+
 protected:
 	static uint32 readVLQ(byte * &data);
 	virtual void resetTracking();
@@ -300,6 +322,9 @@ protected:
 	void hangingNote(byte channel, byte note, uint32 ticksLeft, bool recycle = true);
 	void hangAllActiveNotes();
 
+	void buildSeekIndex();
+	void seekToIndexedTick(uint32 tick);
+
 	virtual void sendToDriver(uint32 b);
 	void sendToDriver(byte status, byte firstOp, byte secondOp) {
 		sendToDriver(status | ((uint32)firstOp << 8) | ((uint32)secondOp << 16));
@@ -245,6 +245,7 @@ bool MidiParser_SMF::loadMusic(byte *data, uint32 size) {
 	// Note that we assume the original data passed in
 	// will persist beyond this call, i.e. we do NOT
 	// copy the data to our own buffer. Take warning....
+	buildSeekIndex();
 	resetTracking();
 	setTempo(500000);
 	setTrack(0);
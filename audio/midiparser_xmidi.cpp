@@ -129,6 +129,13 @@ void MidiParser_XMIDI::parseNextEvent(EventInfo &info) {
 		info.basic.param1 = *(_position._playPos++);
 		info.basic.param2 = *(_position._playPos++);
 
+		// Loops and callbacks depend on state the seek index does not
+		// keep, so jumps past them still parse the track from there.
+		if (_buildingSeekIndex && info.basic.param1 >= 0x6e && info.basic.param1 <= 0x78) {
+			_seekIndexStopped = true;
+			break;
+		}
+
 		// This isn't a full XMIDI implementation, but it should
 		// hopefully be "good enough" for most things.
 
@@ -378,6 +385,7 @@ bool MidiParser_XMIDI::loadMusic(byte *data, uint32 size) {
 		// will persist beyond this call, i.e. we do NOT
 		// copy the data to our own buffer. Take warning....
 		_ppqn = 60;
+		buildSeekIndex();
 		resetTracking();
 		setTempo(500000);
 		setTrack(0);
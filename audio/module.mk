@@ -3,6 +3,7 @@ MODULE := audio
 MODULE_OBJS := \
 	adlib.o \
 	audiostream.o \
+	decodedcache.o \
 	fmopl.o \
 	mididrv.o \
 	midiparser_qt.o \
@@ -16,6 +17,7 @@ MODULE_OBJS := \
 	mpu401.o \
 	musicplugin.o \
 	null.o \
+	opl_capture.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -51,6 +53,7 @@ MODULE_OBJS := \
 	softsynth/fmtowns_pc98/towns_pc98_fmsynth.o \
 	softsynth/fmtowns_pc98/towns_pc98_plugins.o \
 	softsynth/appleiigs.o \
+	softsynth/emumidi.o \
 	softsynth/fluidsynth.o \
 	softsynth/mt32.o \
 	softsynth/eas.o \
@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#include "audio/opl_capture.h"
+
+#include "common/endian.h"
+#include "common/file.h"
+#include "common/textconsole.h"
+
+namespace OPL {
+
+CaptureOPL::CaptureOPL(OPL *opl, Config::OplType type, const Common::String &filename)
+	: OPL(opl), _opl(opl), _file(new Common::DumpFile()), _tick(0) {
+	if (!_file->open(filename)) {
+		warning("Could not open OPL capture file '%s'", filename.c_str());
+		delete _file;
+		_file = 0;
+		return;
+	}
+
+	byte header[8];
+	WRITE_BE_UINT32(header, kCaptureMagic);
+	header[4] = kCaptureVersion;
+	header[5] = type;
+	WRITE_LE_UINT16(header + 6, 0);
+	_file->write(header, sizeof(header));
+}
+
+CaptureOPL::~CaptureOPL() {
+	stop();
+	delete _opl;
+
+	if (_file) {
+		_file->finalize();
+		delete _file;
+	}
+}
+
+bool CaptureOPL::init() {
+	record(kCaptureReset, 0, 0);
+	return _opl->init();
+}
+
+void CaptureOPL::reset() {
+	record(kCaptureReset, 0, 0);
+	_opl->reset();
+}
+
+void CaptureOPL::write(int a, int v) {
+	record(kCaptureWrite, a, v);
+	_opl->write(a, v);
+}
+
+byte CaptureOPL::read(int a) {
+	return _opl->read(a);
+}
+
+void CaptureOPL::writeReg(int r, int v) {
+	record(kCaptureWriteReg, r, v);
+	_opl->writeReg(r, v);
+}
+
+void CaptureOPL::setCallbackFrequency(int timerFrequency) {
+	record(kCaptureFrequency, timerFrequency, 0);
+	_opl->setCallbackFrequency(timerFrequency);
+}
+
+void CaptureOPL::startCallbacks(int timerFrequency) {
+	record(kCaptureFrequency, timerFrequency, 0);
+	_opl->start(new Common::Functor0Mem<void, CaptureOPL>(this, &CaptureOPL::onTimer), timerFrequency);
+}
+
+void CaptureOPL::stopCallbacks() {
+	_opl->stop();
+}
+
+void CaptureOPL::onTimer() {
+	{
+		Common::StackLock lock(_mutex);
+		_tick++;
+	}
+
+	if (_callback && _callback->isValid())
+		(*_callback)();
+}
+
+void CaptureOPL::record(CaptureEventKind kind, int addr, int value) {
+	if (!_file)
+		return;
+
+	byte event[8];
+	Common::StackLock lock(_mutex);
+	WRITE_LE_UINT32(event, _tick);
+	event[4] = kind;
+	event[5] = value;
+	WRITE_LE_UINT16(event + 6, addr);
+	_file->write(event, sizeof(event));
+}
+
+} // End of namespace OPL
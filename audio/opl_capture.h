@@ -0,0 +1,104 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+#ifndef AUDIO_OPL_CAPTURE_H
+#define AUDIO_OPL_CAPTURE_H
+
+#include "audio/fmopl.h"
+
+#include "common/mutex.h"
+
+namespace Common {
+class DumpFile;
+}
+
+namespace OPL {
+
+/**
+ * File format of OPL register captures.
+ *
+ * A capture starts with a header, which is followed by a list of events.
+ * Apart from the magic, all values are stored in little endian byte order.
+ *
+ * Header (8 bytes):
+ *   uint32 magic   kCaptureMagic, big endian
+ *   uint8 version  kCaptureVersion
+ *   uint8 type     the Config::OplType the engine requested
+ *   uint16 unused
+ *
+ * Event (8 bytes):
+ *   uint32 tick    number of timer callbacks that happened before the event
+ *   uint8 kind     one of CaptureEventKind
+ *   uint8 value    value written
+ *   uint16 addr    port (kCaptureWrite), register (kCaptureWriteReg) or
+ *                  callback frequency in Hz (kCaptureFrequency)
+ */
+enum {
+	kCaptureMagic = 0x4F504C43, // 'OPLC'
+	kCaptureVersion = 1
+};
+
+enum CaptureEventKind {
+	kCaptureWrite = 0,
+	kCaptureWriteReg = 1,
+	kCaptureFrequency = 2,
+	kCaptureReset = 3
+};
+
+/**
+ * An OPL which forwards everything to another OPL instance and records all
+ * writes with the timer callback they happened in. This allows to replay a
+ * game session through the different emulators, see devtools/opl_replay.
+ */
+class CaptureOPL : public OPL {
+public:
+	/**
+	 * Starts recording to the given file. Takes ownership of the OPL.
+	 */
+	CaptureOPL(OPL *opl, Config::OplType type, const Common::String &filename);
+	virtual ~CaptureOPL();
+
+	// OPL API
+	bool init();
+	void reset();
+	void write(int a, int v);
+	byte read(int a);
+	void writeReg(int r, int v);
+	void setCallbackFrequency(int timerFrequency);
+
+protected:
+	// OPL API
+	void startCallbacks(int timerFrequency);
+	void stopCallbacks();
+
+private:
+	void onTimer();
+	void record(CaptureEventKind kind, int addr, int value);
+
+	OPL *_opl;
+	Common::DumpFile *_file;
+	Common::Mutex _mutex;
+	uint32 _tick;
+};
+
+} // End of namespace OPL
+
+#endif
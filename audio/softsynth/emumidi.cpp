@@ -0,0 +1,166 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "audio/softsynth/emumidi.h"
+
+#include "common/textconsole.h"
+
+MidiDriver_Emulated::~MidiDriver_Emulated() {
+	clearScheduledEvents();
+}
+
+void MidiDriver_Emulated::sendDelayed(uint32 b, uint32 delay) {
+	scheduleEvent(b, 0, 0, delay);
+}
+
+void MidiDriver_Emulated::sysExDelayed(const byte *msg, uint16 length, uint32 delay) {
+	scheduleEvent(0, msg, length, delay);
+}
+
+void MidiDriver_Emulated::scheduleEvent(uint32 b, const byte *msg, uint16 length, uint32 delay) {
+	{
+		Common::StackLock lock(_scheduledMutex);
+
+		// Unless there is something to wait for, the event is played
+		// right away below
+		if (_isOpen && (_scheduledCount > 0 || (delay > 0 && _inTimerCallback)) && _scheduledCount < kMaxScheduledEvents) {
+			ScheduledEvent event;
+			event.b = b;
+			event.sysExData = 0;
+			event.sysExLength = length;
+			if (msg) {
+				event.sysExData = new byte[length];
+				memcpy(event.sysExData, msg, length);
+			}
+
+			if (_inTimerCallback) {
+				// Convert without overflowing for delays of many seconds
+				const uint32 rate = getRate();
+				event.time = _samplePosition + (delay / 1000) * rate / 1000 + (delay % 1000) * rate / 1000000;
+			} else {
+				event.time = _scheduledEvents[(_scheduledStart + _scheduledCount - 1) % kMaxScheduledEvents].time;
+			}
+
+			// Insert after all events which are due at the same time or
+			// earlier, so that the order of sending is kept among them.
+			uint pos = _scheduledCount;
+			while (pos > 0) {
+				const ScheduledEvent &prev = _scheduledEvents[(_scheduledStart + pos - 1) % kMaxScheduledEvents];
+				if ((int32)(event.time - prev.time) >= 0)
+					break;
+				_scheduledEvents[(_scheduledStart + pos) % kMaxScheduledEvents] = prev;
+				--pos;
+			}
+			_scheduledEvents[(_scheduledStart + pos) % kMaxScheduledEvents] = event;
+			++_scheduledCount;
+			return;
+		}
+
+		if (_scheduledCount == kMaxScheduledEvents)
+			warning("MidiDriver_Emulated: Too many scheduled events, playing them early");
+	}
+
+	// The queue is empty unless it overflowed, in which case everything
+	// pending is played first to keep the order of events.
+	dispatchScheduledEvents(0, true);
+	if (msg)
+		sysEx(msg, length);
+	else
+		send(b);
+}
+
+int MidiDriver_Emulated::dispatchScheduledEvents(int maxStep, bool all) {
+	_scheduledMutex.lock();
+	while (_scheduledCount > 0) {
+		ScheduledEvent event = _scheduledEvents[_scheduledStart];
+		const int32 samplesLeft = (int32)(event.time - _samplePosition);
+		if (samplesLeft > 0 && !all) {
+			if (maxStep > samplesLeft)
+				maxStep = samplesLeft;
+			break;
+		}
+
+		_scheduledStart = (_scheduledStart + 1) % kMaxScheduledEvents;
+		--_scheduledCount;
+
+		// The driver may take its own locks, so do not hold ours meanwhile
+		_scheduledMutex.unlock();
+		if (event.sysExData)
+			sysEx(event.sysExData, event.sysExLength);
+		else
+			send(event.b);
+		delete[] event.sysExData;
+		_scheduledMutex.lock();
+	}
+	_scheduledMutex.unlock();
+
+	return maxStep;
+}
+
+void MidiDriver_Emulated::clearScheduledEvents() {
+	Common::StackLock lock(_scheduledMutex);
+
+	while (_scheduledCount > 0) {
+		delete[] _scheduledEvents[_scheduledStart].sysExData;
+		_scheduledStart = (_scheduledStart + 1) % kMaxScheduledEvents;
+		--_scheduledCount;
+	}
+	_scheduledStart = 0;
+}
+
+int MidiDriver_Emulated::readBuffer(int16 *data, const int numSamples) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int len = numSamples / stereoFactor;
+	int step;
+
+	do {
+		step = len;
+		if (step > (_nextTick >> FIXP_SHIFT))
+			step = (_nextTick >> FIXP_SHIFT);
+
+		// Play the events which are due and stop rendering at the next one
+		if (_scheduledCount)
+			step = dispatchScheduledEvents(step, false);
+
+		generateSamples(data, step);
+		_samplePosition += step;
+
+		_nextTick -= step << FIXP_SHIFT;
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			_inTimerCallback = true;
+
+			if (_timerProc)
+				(*_timerProc)(_timerParam);
+
+			onTimer();
+
+			_inTimerCallback = false;
+
+			_nextTick += _samplesPerTick;
+		}
+
+		data += step * stereoFactor;
+		len -= step;
+	} while (len);
+
+	return numSamples;
+}
@@ -27,6 +27,8 @@
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
 
+#include "common/mutex.h"
+
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
 	bool _isOpen;
@@ -44,6 +46,34 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	/**
+	 * A MIDI command or sysEx which was sent with a delay and waits for the
+	 * output to reach the sample at which it takes effect.
+	 */
+	struct ScheduledEvent {
+		uint32 time;        ///< Output sample position of the event
+		uint32 b;           ///< Packed MIDI command, unused for sysEx
+		byte *sysExData;    ///< Copy of the sysEx data, 0 for MIDI commands
+		uint16 sysExLength;
+	};
+
+	enum {
+		kMaxScheduledEvents = 256
+	};
+
+	/** Ring buffer of scheduled events, kept sorted by time. */
+	ScheduledEvent _scheduledEvents[kMaxScheduledEvents];
+	uint _scheduledStart;
+	uint _scheduledCount;
+	Common::Mutex _scheduledMutex;
+
+	uint32 _samplePosition;
+	bool _inTimerCallback;
+
+	void scheduleEvent(uint32 b, const byte *msg, uint16 length, uint32 delay);
+	int dispatchScheduledEvents(int maxStep, bool all);
+	void clearScheduledEvents();
+
 protected:
 	int _baseFreq;
 
@@ -58,9 +88,15 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_scheduledStart(0),
+		_scheduledCount(0),
+		_samplePosition(0),
+		_inTimerCallback(false),
 		_baseFreq(250) {
 	}
 
+	virtual ~MidiDriver_Emulated();
+
 	// MidiDriver API
 	virtual int open() {
 		_isOpen = true;
@@ -73,6 +109,8 @@ public:
 
 		_samplesPerTick = (d << FIXP_SHIFT) + (r << FIXP_SHIFT) / _baseFreq;
 
+		clearScheduledEvents();
+
 		return 0;
 	}
 
@@ -87,35 +125,19 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
-	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
+	/**
+	 * Delayed events are queued with the output sample at which they take
+	 * effect, and readBuffer() splits rendering exactly there. The delay is
+	 * counted from the sample at which the timer callback sending the event
+	 * was made, so events keep their spacing within a timer period at the
+	 * cost of one period of latency. Events sent outside the timer callback
+	 * are played after any event still queued.
+	 */
+	virtual void sendDelayed(uint32 b, uint32 delay);
+	virtual void sysExDelayed(const byte *msg, uint16 length, uint32 delay);
 
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
-
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
-
-		return numSamples;
-	}
+	// AudioStream API
+	virtual int readBuffer(int16 *data, const int numSamples);
 
 	virtual bool endOfData() const {
 		return false;
@@ -25,6 +25,13 @@
 #include "common/textconsole.h"
 #include "common/util.h"
 
+// Envelope level of an operator whose envelope has ended, see
+// TownsPC98_FmSynthOperator::generateEnvelope()
+static const uint32 kOprIdleLevel = 0xffffffff;
+
+// Number of samples the operator envelopes are generated for at once
+static const uint32 kEnvelopeBlockSize = 128;
+
 class TownsPC98_FmSynthOperator {
 public:
 	TownsPC98_FmSynthOperator(const uint32 timerbase, const uint32 rtt, const uint8 *rateTable,
@@ -37,7 +44,12 @@ public:
 	void frequency(int freq);
 	void updatePhaseIncrement();
 	void recalculateRates();
-	void generateOutput(int32 phasebuf, int32 *feedbuf, int32 &out);
+	void generateEnvelope(uint32 *levels, uint32 count);
+	void generateOutput(uint32 level, int32 phasebuf, int32 *feedbuf, int32 &out);
+
+	bool isIdle() const {
+		return _state == kEnvReady;
+	}
 
 	void feedbackLevel(int32 level);
 	void detune(int value);
@@ -53,6 +65,8 @@ public:
 	void reset();
 
 protected:
+	bool advanceEnvelope();
+
 	EnvelopeState _state;
 	bool _holdKey;
 	uint32 _feedbackLevel;
@@ -162,9 +176,16 @@ void TownsPC98_FmSynthOperator::recalculateRates() {
 	fs_r.shift = _rshiftTbl[r + k];
 }
 
-void TownsPC98_FmSynthOperator::generateOutput(int32 phasebuf, int32 *feed, int32 &out) {
+void TownsPC98_FmSynthOperator::generateEnvelope(uint32 *levels, uint32 count) {
+	// The envelope does not depend on the other operators, so it is run
+	// for a whole block at once, ahead of the output.
+	for (uint32 i = 0; i < count; i++)
+		levels[i] = advanceEnvelope() ? _totalLevel + (uint32) _currentLevel : kOprIdleLevel;
+}
+
+bool TownsPC98_FmSynthOperator::advanceEnvelope() {
 	if (_state == kEnvReady)
-		return;
+		return false;
 
 	_timer += _tickLength;
 	while (_timer > _rtt) {
@@ -179,7 +200,7 @@ void TownsPC98_FmSynthOperator::generateOutput(int32 phasebuf, int32 *feed, int3
 		for (bool loop = true; loop;) {
 			switch (_state) {
 			case kEnvReady:
-				return;
+				return false;
 			case kEnvAttacking:
 				targetLevel = 0;
 				nextState = _sustainLevel ? kEnvDecaying : kEnvSustaining;
@@ -224,8 +245,12 @@ void TownsPC98_FmSynthOperator::generateOutput(int32 phasebuf, int32 *feed, int3
 		}
 	}
 
-	uint32 lvlout = _totalLevel + (uint32) _currentLevel;
+	return true;
+}
 
+void TownsPC98_FmSynthOperator::generateOutput(uint32 lvlout, int32 phasebuf, int32 *feed, int32 &out) {
+	if (lvlout == kOprIdleLevel)
+		return;
 
 	int32 outp = 0;
 	int32 *i = &outp, *o = &outp;
@@ -343,10 +368,12 @@ public:
 	void setVolumeIntern(int volA, int volB) {
 		_volumeA = volA;
 		_volumeB = volB;
+		updateOutputLevels();
 	}
 	void setVolumeChannelMasks(int channelMaskA, int channelMaskB) {
 		_volMaskA = channelMaskA;
 		_volMaskB = channelMaskB;
+		updateOutputLevels();
 	}
 
 	uint8 chanEnable() const {
@@ -354,6 +381,7 @@ public:
 	}
 private:
 	void updateRegs();
+	void updateOutputLevels();
 
 	uint8 _updateRequestBuf[64];
 	int _updateRequest;
@@ -372,6 +400,10 @@ private:
 	int32 *_tlTable;
 	int32 *_tleTable;
 
+	// The level tables above with the volume settings of each channel applied
+	int32 _chanTlTable[3][16];
+	int32 _chanTleTable[3][32];
+
 	const uint32 _tickLength;
 	uint32 _timer;
 	const uint32 _rtt;
@@ -489,6 +521,9 @@ TownsPC98_FmSynthSquareSineSource::TownsPC98_FmSynthSquareSineSource(const uint3
 	_reg[9] = &_channels[1].vol;
 	_reg[10] = &_channels[2].vol;
 
+	memset(_chanTlTable, 0, sizeof(_chanTlTable));
+	memset(_chanTleTable, 0, sizeof(_chanTleTable));
+
 	reset();
 }
 
@@ -531,6 +566,7 @@ void TownsPC98_FmSynthSquareSineSource::init(const int *rsTable, const int *rseT
 	}
 
 	_ready = true;
+	updateOutputLevels();
 }
 
 void TownsPC98_FmSynthSquareSineSource::reset() {
@@ -583,6 +619,12 @@ void TownsPC98_FmSynthSquareSineSource::nextTick(int32 *buffer, uint32 bufferSiz
 	if (!_ready)
 		return;
 
+	// The registers only change in updateRegs(), so the tone periods are
+	// kept here and only reread after an update.
+	int period[3];
+	for (int ii = 0; ii < 3; ii++)
+		period[ii] = ((_channels[ii].frqH & 0x0f) << 8) | _channels[ii].frqL;
+
 	for (uint32 i = 0; i < bufferSize; i++) {
 		_timer += _tickLength;
 		while (_timer > _rtt) {
@@ -597,7 +639,7 @@ void TownsPC98_FmSynthSquareSineSource::nextTick(int32 *buffer, uint32 bufferSiz
 			}
 
 			for (int ii = 0; ii < 3; ii++) {
-				if (++_channels[ii].tick >= (((_channels[ii].frqH & 0x0f) << 8) | _channels[ii].frqL)) {
+				if (++_channels[ii].tick >= period[ii]) {
 					_channels[ii].tick = 0;
 					_channels[ii].smp ^= 1;
 				}
@@ -619,20 +661,21 @@ void TownsPC98_FmSynthSquareSineSource::nextTick(int32 *buffer, uint32 bufferSiz
 				}
 			}
 			_pReslt = _evpTimer ^ _attack;
-			updateRegs();
+
+			if (_updateRequest >= 0) {
+				updateRegs();
+				for (int ii = 0; ii < 3; ii++)
+					period[ii] = ((_channels[ii].frqH & 0x0f) << 8) | _channels[ii].frqL;
+			}
 		}
 
 		int32 finOut = 0;
 		for (int ii = 0; ii < 3; ii++) {
-			int32 finOutTemp = ((_channels[ii].vol >> 4) & 1) ? _tleTable[_channels[ii].out ? _pReslt : 0] : _tlTable[_channels[ii].out ? (_channels[ii].vol & 0x0f) : 0];
-
-			if ((1 << ii) & _volMaskA)
-				finOutTemp = (finOutTemp * _volumeA) / Audio::Mixer::kMaxMixerVolume;
-
-			if ((1 << ii) & _volMaskB)
-				finOutTemp = (finOutTemp * _volumeB) / Audio::Mixer::kMaxMixerVolume;
-
-			finOut += finOutTemp;
+			const Channel &c = _channels[ii];
+			if ((c.vol >> 4) & 1)
+				finOut += _chanTleTable[ii][c.out ? _pReslt : 0];
+			else
+				finOut += _chanTlTable[ii][c.out ? (c.vol & 0x0f) : 0];
 		}
 
 		finOut /= 3;
@@ -651,6 +694,32 @@ void TownsPC98_FmSynthSquareSineSource::updateRegs() {
 	_updateRequest = -1;
 }
 
+void TownsPC98_FmSynthSquareSineSource::updateOutputLevels() {
+	if (!_ready)
+		return;
+
+	for (int ii = 0; ii < 3; ii++) {
+		for (int i = 0; i < 32; i++) {
+			int32 tl = i < 16 ? _tlTable[i] : 0;
+			int32 tle = _tleTable[i];
+
+			if ((1 << ii) & _volMaskA) {
+				tl = (tl * _volumeA) / Audio::Mixer::kMaxMixerVolume;
+				tle = (tle * _volumeA) / Audio::Mixer::kMaxMixerVolume;
+			}
+
+			if ((1 << ii) & _volMaskB) {
+				tl = (tl * _volumeB) / Audio::Mixer::kMaxMixerVolume;
+				tle = (tle * _volumeB) / Audio::Mixer::kMaxMixerVolume;
+			}
+
+			if (i < 16)
+				_chanTlTable[ii][i] = tl;
+			_chanTleTable[ii][i] = tle;
+		}
+	}
+}
+
 #ifndef DISABLE_PC98_RHYTHM_CHANNEL
 TownsPC98_FmSynthPercussionSource::TownsPC98_FmSynthPercussionSource(const uint32 timerbase, const uint32 rtt) :
 	_rtt(rtt), _tickLength(timerbase * 2), _timer(0), _totalLevel(0), _volMaskA(0), _volMaskB(0),
@@ -785,6 +854,9 @@ void TownsPC98_FmSynthPercussionSource::nextTick(int32 *buffer, uint32 bufferSiz
 	if (!_ready)
 		return;
 
+	int32 finOut = 0;
+	bool updateOutput = true;
+
 	for (uint32 i = 0; i < bufferSize; i++) {
 		_timer += _tickLength;
 		while (_timer > _rtt) {
@@ -800,24 +872,29 @@ void TownsPC98_FmSynthPercussionSource::nextTick(int32 *buffer, uint32 bufferSiz
 							s->active = false;
 					}
 					s->decStep ^= 1;
+					updateOutput = true;
 				}
 			}
 		}
 
-		int32 finOut = 0;
+		// The output only changes when an active channel is ticked
+		if (updateOutput) {
+			updateOutput = false;
+			finOut = 0;
 
-		for (int ii = 0; ii < 6; ii++) {
-			if (_rhChan[ii].active)
-				finOut += _rhChan[ii].out;
-		}
+			for (int ii = 0; ii < 6; ii++) {
+				if (_rhChan[ii].active)
+					finOut += _rhChan[ii].out;
+			}
 
-		finOut <<= 1;
+			finOut <<= 1;
 
-		if (1 & _volMaskA)
-			finOut = (finOut * _volumeA) / Audio::Mixer::kMaxMixerVolume;
+			if (1 & _volMaskA)
+				finOut = (finOut * _volumeA) / Audio::Mixer::kMaxMixerVolume;
 
-		if (1 & _volMaskB)
-			finOut = (finOut * _volumeB) / Audio::Mixer::kMaxMixerVolume;
+			if (1 & _volMaskB)
+				finOut = (finOut * _volumeB) / Audio::Mixer::kMaxMixerVolume;
+		}
 
 		buffer[i << 1] += finOut;
 		buffer[(i << 1) + 1] += finOut;
@@ -1355,96 +1432,118 @@ void TownsPC98_FmSynth::nextTick(int32 *buffer, uint32 bufferSize) {
 	if (!_ready)
 		return;
 
+	const int32 outputDivisor = (_numChan + _numSSG - 3) / 3;
+	uint32 levels[4][kEnvelopeBlockSize];
+
 	for (int i = 0; i < _numChan; i++) {
-		TownsPC98_FmSynthOperator **o = _chanInternal[i].opr;
+		ChanInternal &chan = _chanInternal[i];
+		TownsPC98_FmSynthOperator **o = chan.opr;
 
-		if (_chanInternal[i].updateEnvelopeParameters) {
-			_chanInternal[i].updateEnvelopeParameters = false;
+		if (chan.updateEnvelopeParameters) {
+			chan.updateEnvelopeParameters = false;
 			for (int ii = 0; ii < 4 ; ii++)
 				o[ii]->updatePhaseIncrement();
 		}
 
+		int32 *del = &chan.feedbuf[2];
+		int32 *feed = chan.feedbuf;
+
+		// Operators whose envelope has ended neither advance nor output
+		// anything. If all of them have, the block would only clear the
+		// delay buffer of the channel.
+		if (o[0]->isIdle() && o[1]->isIdle() && o[2]->isIdle() && o[3]->isIdle()) {
+			*del = 0;
+			continue;
+		}
+
+		const bool applyVolumeA = ((1 << i) & _volMaskA) != 0;
+		const bool applyVolumeB = ((1 << i) & _volMaskB) != 0;
+		int32 *leftSample = chan.enableLeft ? buffer : 0;
+		int32 *rightSample = chan.enableRight ? buffer + 1 : 0;
+
 		for (uint32 ii = 0; ii < bufferSize ; ii++) {
+			if (!(ii & (kEnvelopeBlockSize - 1))) {
+				const uint32 count = MIN<uint32>(bufferSize - ii, kEnvelopeBlockSize);
+				for (int k = 0; k < 4; k++)
+					o[k]->generateEnvelope(levels[k], count);
+			}
+
+			const uint32 pos = ii & (kEnvelopeBlockSize - 1);
 			int32 phbuf1, phbuf2, output;
 			phbuf1 = phbuf2 = output = 0;
 
-			int32 *leftSample = &buffer[ii * 2];
-			int32 *rightSample = &buffer[ii * 2 + 1];
-			int32 *del = &_chanInternal[i].feedbuf[2];
-			int32 *feed = _chanInternal[i].feedbuf;
-
-			switch (_chanInternal[i].algorithm) {
+			switch (chan.algorithm) {
 			case 0:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, 0, phbuf2);
+				o[0]->generateOutput(levels[0][pos], 0, feed, phbuf1);
+				o[2]->generateOutput(levels[2][pos], *del, 0, phbuf2);
 				*del = 0;
-				o[1]->generateOutput(phbuf1, 0, *del);
-				o[3]->generateOutput(phbuf2, 0, output);
+				o[1]->generateOutput(levels[1][pos], phbuf1, 0, *del);
+				o[3]->generateOutput(levels[3][pos], phbuf2, 0, output);
 				break;
 			case 1:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, 0, phbuf2);
-				o[1]->generateOutput(0, 0, phbuf1);
-				o[3]->generateOutput(phbuf2, 0, output);
+				o[0]->generateOutput(levels[0][pos], 0, feed, phbuf1);
+				o[2]->generateOutput(levels[2][pos], *del, 0, phbuf2);
+				o[1]->generateOutput(levels[1][pos], 0, 0, phbuf1);
+				o[3]->generateOutput(levels[3][pos], phbuf2, 0, output);
 				*del = phbuf1;
 				break;
 			case 2:
-				o[0]->generateOutput(0, feed, phbuf2);
-				o[2]->generateOutput(*del, 0, phbuf2);
-				o[1]->generateOutput(0, 0, phbuf1);
-				o[3]->generateOutput(phbuf2, 0, output);
+				o[0]->generateOutput(levels[0][pos], 0, feed, phbuf2);
+				o[2]->generateOutput(levels[2][pos], *del, 0, phbuf2);
+				o[1]->generateOutput(levels[1][pos], 0, 0, phbuf1);
+				o[3]->generateOutput(levels[3][pos], phbuf2, 0, output);
 				*del = phbuf1;
 				break;
 			case 3:
-				o[0]->generateOutput(0, feed, phbuf2);
-				o[2]->generateOutput(0, 0, *del);
-				o[1]->generateOutput(phbuf2, 0, phbuf1);
-				o[3]->generateOutput(*del, 0, output);
+				o[0]->generateOutput(levels[0][pos], 0, feed, phbuf2);
+				o[2]->generateOutput(levels[2][pos], 0, 0, *del);
+				o[1]->generateOutput(levels[1][pos], phbuf2, 0, phbuf1);
+				o[3]->generateOutput(levels[3][pos], *del, 0, output);
 				*del = phbuf1;
 				break;
 			case 4:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(0, 0, phbuf2);
-				o[1]->generateOutput(phbuf1, 0, output);
-				o[3]->generateOutput(phbuf2, 0, output);
+				o[0]->generateOutput(levels[0][pos], 0, feed, phbuf1);
+				o[2]->generateOutput(levels[2][pos], 0, 0, phbuf2);
+				o[1]->generateOutput(levels[1][pos], phbuf1, 0, output);
+				o[3]->generateOutput(levels[3][pos], phbuf2, 0, output);
 				*del = 0;
 				break;
 			case 5:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, 0, output);
-				o[1]->generateOutput(phbuf1, 0, output);
-				o[3]->generateOutput(phbuf1, 0, output);
+				o[0]->generateOutput(levels[0][pos], 0, feed, phbuf1);
+				o[2]->generateOutput(levels[2][pos], *del, 0, output);
+				o[1]->generateOutput(levels[1][pos], phbuf1, 0, output);
+				o[3]->generateOutput(levels[3][pos], phbuf1, 0, output);
 				*del = phbuf1;
 				break;
 			case 6:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(0, 0, output);
-				o[1]->generateOutput(phbuf1, 0, output);
-				o[3]->generateOutput(0, 0, output);
+				o[0]->generateOutput(levels[0][pos], 0, feed, phbuf1);
+				o[2]->generateOutput(levels[2][pos], 0, 0, output);
+				o[1]->generateOutput(levels[1][pos], phbuf1, 0, output);
+				o[3]->generateOutput(levels[3][pos], 0, 0, output);
 				*del = 0;
 				break;
 			case 7:
-				o[0]->generateOutput(0, feed, output);
-				o[2]->generateOutput(0, 0, output);
-				o[1]->generateOutput(0, 0, output);
-				o[3]->generateOutput(0, 0, output);
+				o[0]->generateOutput(levels[0][pos], 0, feed, output);
+				o[2]->generateOutput(levels[2][pos], 0, 0, output);
+				o[1]->generateOutput(levels[1][pos], 0, 0, output);
+				o[3]->generateOutput(levels[3][pos], 0, 0, output);
 				*del = 0;
 				break;
 			};
 
-			int32 finOut = (output << 2) / ((_numChan + _numSSG - 3) / 3);
+			int32 finOut = (output << 2) / outputDivisor;
 
-			if ((1 << i) & _volMaskA)
+			if (applyVolumeA)
 				finOut = (finOut * _volumeA) / Audio::Mixer::kMaxMixerVolume;
 
-			if ((1 << i) & _volMaskB)
+			if (applyVolumeB)
 				finOut = (finOut * _volumeB) / Audio::Mixer::kMaxMixerVolume;
 
-			if (_chanInternal[i].enableLeft)
-				*leftSample += finOut;
+			if (leftSample)
+				leftSample[ii << 1] += finOut;
 
-			if (_chanInternal[i].enableRight)
-				*rightSample += finOut;
+			if (rightSample)
+				rightSample[ii << 1] += finOut;
 		}
 	}
 }
@@ -268,7 +268,13 @@ void CombFilter::process(const Sample in) {
 }
 
 Sample CombFilter::getOutputAt(const Bit32u outIndex) const {
-	return buffer[(size + index - outIndex) % size];
+	// Equivalent to (size + index - outIndex) % size for outIndex <= size + index,
+	// but avoids a division per output tap
+	Bit32u outPosition = size + index - outIndex;
+	if (outPosition >= size) {
+		outPosition -= size;
+	}
+	return buffer[outPosition];
 }
 
 void CombFilter::setFeedbackFactor(const Bit32u useFeedbackFactor) {
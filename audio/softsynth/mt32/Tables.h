@@ -51,6 +51,9 @@ public:
 	Bit16u exp9[512];
 	Bit16u logsin9[512];
 
+	// exp9 with the 3 lower bits of a 12-bit fractional argument interpolated, as done by LA32Utilites::interpolateExp()
+	Bit16u interpolatedExp[4096];
+
 	const Bit8u *resAmpDecayFactor;
 };
 
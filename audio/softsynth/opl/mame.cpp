@@ -545,6 +545,14 @@ inline void OPL_CALC_CH(OPL_CH *CH) {
 	}
 }
 
+/* ---------- white noise ---------- */
+// Same generator as Common::RandomSource::getRandomBit().
+inline uint getNoiseBit(FM_OPL *OPL) {
+	OPL->noiseSeed = 0xDEADBF03 * (OPL->noiseSeed + 1);
+	OPL->noiseSeed = (OPL->noiseSeed >> 13) | (OPL->noiseSeed << 19);
+	return OPL->noiseSeed & 1;
+}
+
 /* ---------- calcrate rythm block ---------- */
 #define WHITE_NOISE_db 6.0
 inline void OPL_CALC_RH(FM_OPL *OPL, OPL_CH *CH) {
@@ -553,7 +561,7 @@ inline void OPL_CALC_RH(FM_OPL *OPL, OPL_CH *CH) {
 	// but EG_STEP = 96.0/EG_ENT, and WHITE_NOISE_db=6.0. So, that's equivalent to
 	// int(OPL->rnd.getRandomBit() * EG_ENT/16). We know that EG_ENT is 4096, or 1024,
 	// or 128, so we can safely avoid any FP ops.
-	int whitenoise = OPL->rnd->getRandomBit() * (EG_ENT>>4);
+	int whitenoise = getNoiseBit(OPL) * (EG_ENT>>4);
 
 	int tone8;
 
@@ -1137,14 +1145,11 @@ FM_OPL *OPLCreate(int type, int clock, int rate) {
 	OPL->rate  = rate;
 	OPL->max_ch = max_ch;
 
-	// Init the random source. Note: We use a fixed name for it here.
-	// So if multiple FM_OPL objects exist in parallel, then their
-	// random sources will have an equal name. At least in the
-	// current EventRecorder implementation, this causes no problems;
-	// but this is probably not guaranteed.
-	// Alas, it does not seem worthwhile to bother much with this
-	// at the time, so I am leaving it as it is.
-	OPL->rnd = new Common::RandomSource("mame");
+	// Seed the white noise generator with a fixed value. The chip output
+	// then only depends on the register writes, which keeps recorded
+	// sessions (see audio/opl_capture.h) reproducible, and it does not
+	// require g_system, so the core can be driven by headless tools.
+	OPL->noiseSeed = 0x4D414D45;
 
 	/* init grobal tables */
 	OPL_initalize(OPL);
@@ -1157,7 +1162,6 @@ FM_OPL *OPLCreate(int type, int clock, int rate) {
 /* ----------  Destroy one of virtual YM3812 ----------       */
 void OPLDestroy(FM_OPL *OPL) {
 	OPL_UnLockTable();
-	delete OPL->rnd;
 	free(OPL);
 }
 
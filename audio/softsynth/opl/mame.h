@@ -28,7 +28,6 @@
 #define AUDIO_SOFTSYNTH_OPL_MAME_H
 
 #include "common/scummsys.h"
-#include "common/random.h"
 
 #include "audio/fmopl.h"
 
@@ -148,7 +147,8 @@ typedef struct fm_opl_f {
 	OPL_UPDATEHANDLER UpdateHandler;	/* stream update handler   */
 	int UpdateParam;					/* stream update parameter */
 
-	Common::RandomSource *rnd;
+	/* white noise generator state */
+	uint32 noiseSeed;
 } FM_OPL;
 
 /* ---------- Generic interface section ---------- */
@@ -55,6 +55,7 @@
 #include "gui/gui-manager.h"
 #include "gui/error.h"
 
+#include "audio/decodedcache.h"
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
 
@@ -509,6 +510,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			// Try to run the game
 			Common::Error result = runGame(plugin, system, specialDebug);
 
+			// The engine has stopped all its sounds, and the clips of
+			// one game are of no use to the next one
+			Audio::DecodedAudioCache::destroy();
+
 #ifdef ENABLE_EVENTRECORDER
 			// Flush Event recorder file. The recorder does not get reinitialized for next game
 			// which is intentional. Only single game per session is allowed.
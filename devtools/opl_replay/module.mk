@@ -0,0 +1,13 @@
+MODULE := devtools/opl_replay
+
+MODULE_OBJS := \
+	opl_replay.o
+
+# Set the name of the executable
+TOOL_EXECUTABLE := opl_replay
+
+# The emulators are taken straight from the audio library
+TOOL_DEPS := audio/libaudio.a common/libcommon.a
+
+# Include common rules
+include $(srcdir)/rules.mk
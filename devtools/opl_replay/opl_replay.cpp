@@ -0,0 +1,385 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+/*
+ * This is a utility for replaying OPL register captures through the OPL
+ * emulators. Captures are recorded by running ScummVM with the
+ * "opl_capture" config key set to a file name. Every emulator renders the
+ * capture as fast as possible; the tool reports the speed of each one and
+ * how far its output is from the first emulator listed.
+ */
+
+// HACK to allow building with the SDL backend on MinGW
+// see bug #1800764 "TOOLS: MinGW tools building broken"
+#ifdef main
+#undef main
+#endif // main
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "audio/opl_capture.h"
+#include "audio/softsynth/opl/dbopl.h"
+#include "audio/softsynth/opl/mame.h"
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/str.h"
+#include "common/tokenizer.h"
+
+struct CaptureEvent {
+	uint32 tick;
+	byte kind;
+	byte value;
+	uint16 addr;
+};
+
+/**
+ * Headless front end for an emulator core, mirroring what the OPL classes in
+ * ScummVM do on top of the core.
+ */
+class Emulator {
+public:
+	Emulator(const char *name, bool stereo) : _name(name), _stereo(stereo), _seconds(0) {}
+	virtual ~Emulator() {}
+
+	virtual void reset() = 0;
+	virtual void write(int a, int v) = 0;
+	virtual void writeReg(int r, int v) = 0;
+	virtual void generate(int16 *buffer, int frames) = 0;
+
+	const char *_name;
+	bool _stereo;
+	double _seconds;
+};
+
+#ifndef DISABLE_DOSBOX_OPL
+class DOSBoxEmulator : public Emulator {
+public:
+	DOSBoxEmulator(OPL::Config::OplType type, uint rate) : Emulator("db", type == OPL::Config::kOpl3), _type(type), _rate(rate), _reg(0) {
+		OPL::DOSBox::DBOPL::InitTables();
+		reset();
+	}
+
+	void reset() {
+		_chip = OPL::DOSBox::DBOPL::Chip();
+		_chip.Setup(_rate);
+		_reg = 0;
+	}
+
+	void write(int port, int val) {
+		if (port & 1) {
+			// Timer registers are handled outside of the core
+			if (_reg < 2 || _reg > 4)
+				_chip.WriteReg(_reg, val);
+		} else {
+			_reg = _chip.WriteAddr(port, val) & (_type == OPL::Config::kOpl3 ? 0x1ff : 0xff);
+		}
+	}
+
+	void writeReg(int r, int v) {
+		uint32 tempReg = _reg;
+		if (_type == OPL::Config::kOpl3 && r >= 0x100) {
+			write(0x222, r);
+			write(0x223, v);
+		} else {
+			write(0x388, r);
+			write(0x389, v);
+		}
+		if (_type == OPL::Config::kOpl3 && tempReg >= 0x100)
+			write(0x222, tempReg & ~0x100);
+		else
+			write(0x388, tempReg);
+	}
+
+	void generate(int16 *buffer, int frames) {
+		int32 tempBuffer[512 * 2];
+		while (frames > 0) {
+			const int todo = MIN(frames, 512);
+			if (_chip.opl3Active) {
+				_chip.GenerateBlock3(todo, tempBuffer);
+				for (int i = 0; i < todo * 2; ++i)
+					buffer[i] = tempBuffer[i];
+			} else {
+				_chip.GenerateBlock2(todo, tempBuffer);
+				for (int i = 0; i < todo; ++i) {
+					if (_stereo)
+						buffer[i * 2] = buffer[i * 2 + 1] = tempBuffer[i];
+					else
+						buffer[i] = tempBuffer[i];
+				}
+			}
+			buffer += _stereo ? todo * 2 : todo;
+			frames -= todo;
+		}
+	}
+
+private:
+	OPL::Config::OplType _type;
+	uint _rate;
+	uint32 _reg;
+	OPL::DOSBox::DBOPL::Chip _chip;
+};
+#endif
+
+class MAMEEmulator : public Emulator {
+public:
+	MAMEEmulator(uint rate) : Emulator("mame", false) {
+		_opl = OPL::MAME::makeAdLibOPL(rate);
+	}
+
+	~MAMEEmulator() {
+		OPL::MAME::OPLDestroy(_opl);
+	}
+
+	void reset() {
+		OPL::MAME::OPLResetChip(_opl);
+	}
+
+	void write(int a, int v) {
+		OPL::MAME::OPLWrite(_opl, a, v);
+	}
+
+	void writeReg(int r, int v) {
+		OPL::MAME::OPLWriteReg(_opl, r, v);
+	}
+
+	void generate(int16 *buffer, int frames) {
+		OPL::MAME::YM3812UpdateOne(_opl, buffer, frames);
+	}
+
+private:
+	OPL::MAME::FM_OPL *_opl;
+};
+
+static bool loadCapture(const char *filename, OPL::Config::OplType &type, Common::Array<CaptureEvent> &events) {
+	FILE *f = fopen(filename, "rb");
+	if (!f) {
+		fprintf(stderr, "Could not open '%s'\n", filename);
+		return false;
+	}
+
+	byte header[8];
+	if (fread(header, sizeof(header), 1, f) != 1 || READ_BE_UINT32(header) != OPL::kCaptureMagic || header[4] != OPL::kCaptureVersion) {
+		fprintf(stderr, "'%s' is not an OPL capture\n", filename);
+		fclose(f);
+		return false;
+	}
+	type = (OPL::Config::OplType)header[5];
+
+	byte data[8];
+	while (fread(data, sizeof(data), 1, f) == 1) {
+		CaptureEvent event;
+		event.tick = READ_LE_UINT32(data);
+		event.kind = data[4];
+		event.value = data[5];
+		event.addr = READ_LE_UINT16(data + 6);
+		events.push_back(event);
+	}
+
+	fclose(f);
+	return true;
+}
+
+static void applyEvent(Emulator *emulator, const CaptureEvent &event) {
+	switch (event.kind) {
+	case OPL::kCaptureWrite:
+		emulator->write(event.addr, event.value);
+		break;
+	case OPL::kCaptureWriteReg:
+		emulator->writeReg(event.addr, event.value);
+		break;
+	case OPL::kCaptureReset:
+		emulator->reset();
+		break;
+	default:
+		break;
+	}
+}
+
+struct Difference {
+	uint64 compared;
+	uint64 identical;
+	int maxDiff;
+	double squareSum;
+
+	Difference() : compared(0), identical(0), maxDiff(0), squareSum(0) {}
+};
+
+static void printUsage() {
+	printf("Usage: opl_replay [-r <rate>] [-e <emulator>[,<emulator>...]] <capture>\n\n");
+	printf("  -r <rate>      Output rate to render at (default: 44100)\n");
+	printf("  -e <list>      Emulators to replay through, the first one is the reference for\n");
+	printf("                 the output differences (default: db,mame)\n");
+}
+
+int main(int argc, char *argv[]) {
+	uint rate = 44100;
+	Common::String emulatorList = "db,mame";
+	const char *filename = 0;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+			rate = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-e") && i + 1 < argc) {
+			emulatorList = argv[++i];
+		} else if (argv[i][0] != '-' && !filename) {
+			filename = argv[i];
+		} else {
+			printUsage();
+			return -1;
+		}
+	}
+
+	if (!filename || !rate) {
+		printUsage();
+		return -1;
+	}
+
+	OPL::Config::OplType type;
+	Common::Array<CaptureEvent> events;
+	if (!loadCapture(filename, type, events))
+		return -1;
+
+	if (type == OPL::Config::kDualOpl2) {
+		fprintf(stderr, "Dual OPL2 captures are not supported\n");
+		return -1;
+	}
+
+	// Everything is rendered in stereo when one of the emulators is stereo,
+	// so the outputs can be compared
+	const bool stereo = (type == OPL::Config::kOpl3);
+
+	Common::Array<Emulator *> emulators;
+	Common::StringTokenizer tokenizer(emulatorList, ",");
+	while (!tokenizer.empty()) {
+		Common::String name = tokenizer.nextToken();
+		if (name.empty())
+			continue;
+#ifndef DISABLE_DOSBOX_OPL
+		if (name == "db") {
+			emulators.push_back(new DOSBoxEmulator(type, rate));
+			continue;
+		}
+#endif
+		if (name == "mame") {
+			if (type == OPL::Config::kOpl2)
+				emulators.push_back(new MAMEEmulator(rate));
+			else
+				printf("Skipping mame, it only supports OPL2\n");
+			continue;
+		}
+		fprintf(stderr, "Unknown emulator '%s'\n", name.c_str());
+		return -1;
+	}
+
+	if (emulators.empty()) {
+		fprintf(stderr, "No emulator to replay through\n");
+		return -1;
+	}
+
+	const int channels = stereo ? 2 : 1;
+	const uint maxFrames = rate / 10 + 1;
+	Common::Array<int16 *> buffers;
+	for (uint i = 0; i < emulators.size(); ++i)
+		buffers.push_back(new int16[maxFrames * 2]);
+	Common::Array<Difference> differences;
+	differences.resize(emulators.size());
+
+	// Same fixed point tick handling as EmulatedOPL
+	const int fixpShift = 16;
+	uint32 samplesPerTick = (rate << fixpShift) / OPL::OPL::kDefaultCallbackFrequency;
+	uint32 remainder = 0;
+	uint64 totalFrames = 0;
+
+	uint eventIndex = 0;
+	for (uint32 tick = 0; eventIndex < events.size(); ++tick) {
+		while (eventIndex < events.size() && events[eventIndex].tick <= tick) {
+			const CaptureEvent &event = events[eventIndex++];
+			if (event.kind == OPL::kCaptureFrequency && event.addr) {
+				samplesPerTick = (rate / event.addr << fixpShift) + ((rate % event.addr) << fixpShift) / event.addr;
+				continue;
+			}
+			for (uint i = 0; i < emulators.size(); ++i)
+				applyEvent(emulators[i], event);
+		}
+
+		remainder += samplesPerTick;
+		uint frames = MIN<uint>(remainder >> fixpShift, maxFrames);
+		remainder &= (1 << fixpShift) - 1;
+
+		for (uint i = 0; i < emulators.size(); ++i) {
+			Emulator *emulator = emulators[i];
+			clock_t start = clock();
+			if (stereo && !emulator->_stereo) {
+				// Widen mono output in place, from the back
+				emulator->generate(buffers[i], frames);
+				for (int j = frames - 1; j >= 0; --j)
+					buffers[i][j * 2] = buffers[i][j * 2 + 1] = buffers[i][j];
+			} else {
+				emulator->generate(buffers[i], frames);
+			}
+			emulator->_seconds += (double)(clock() - start) / CLOCKS_PER_SEC;
+
+			if (i == 0)
+				continue;
+			Difference &diff = differences[i];
+			for (uint j = 0; j < frames * channels; ++j) {
+				const int delta = abs(buffers[i][j] - buffers[0][j]);
+				diff.compared++;
+				if (!delta)
+					diff.identical++;
+				diff.maxDiff = MAX(diff.maxDiff, delta);
+				diff.squareSum += (double)delta * delta;
+			}
+		}
+		totalFrames += frames;
+	}
+
+	const char *typeNames[] = { "OPL2", "Dual OPL2", "OPL3" };
+	printf("%s: %s, %d events, %.1f seconds at %d Hz\n\n", filename, typeNames[type], events.size(), (double)totalFrames / rate, rate);
+	printf("%-10s %14s %10s %10s %10s %10s\n", "emulator", "samples/sec", "realtime", "max diff", "rms diff", "identical");
+	for (uint i = 0; i < emulators.size(); ++i) {
+		const Emulator *emulator = emulators[i];
+		const double speed = emulator->_seconds > 0 ? totalFrames / emulator->_seconds : 0;
+		printf("%-10s %14.0f %9.1fx", emulator->_name, speed, speed / rate);
+		if (i == 0) {
+			printf(" %10s %10s %10s\n", "-", "-", "-");
+		} else {
+			const Difference &diff = differences[i];
+			const double rms = diff.compared ? sqrt(diff.squareSum / diff.compared) : 0;
+			const double identical = diff.compared ? 100.0 * diff.identical / diff.compared : 100.0;
+			printf(" %10d %10.2f %9.2f%%\n", diff.maxDiff, rms, identical);
+		}
+	}
+
+	for (uint i = 0; i < emulators.size(); ++i) {
+		delete emulators[i];
+		delete[] buffers[i];
+	}
+
+	return 0;
+}
@@ -1741,6 +1741,14 @@ AdjustBoxResult Actor::adjustXYToBeInBox(int dstX, int dstY) {
 		bestDist = (_vm->_game.version >= 7) ? 0x7FFFFFFF : 0xFFFF;
 		bestBox = kInvalidBox;
 
+		// Ask the box cache which boxes can be near the target at all, so
+		// that we don't need to look at the coordinates of the others.
+		uint32 nearBoxes[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+		if (threshold > 0) {
+			const Common::Rect area(dstX - threshold, dstY - threshold, dstX + threshold + 1, dstY + threshold + 1);
+			_vm->getBoxCache()->findBoxesNear(area, nearBoxes);
+		}
+
 		// We iterate (backwards) over all boxes, searching the one closest
 		// to the desired coordinates.
 		for (box = numBoxes; box >= firstValidBox; box--) {
@@ -1750,6 +1758,9 @@ AdjustBoxResult Actor::adjustXYToBeInBox(int dstX, int dstY) {
 			if ((flags & kBoxInvisible) && !((flags & kBoxPlayerOnly) && !isPlayer()))
 				continue;
 
+			if (threshold > 0 && box < 256 && !(nearBoxes[box >> 5] & (1U << (box & 31))))
+				continue;
+
 			// For increased performance, we perform a quick test if
 			// the coordinates can even be within a distance of 'threshold'
 			// pixels of the box.
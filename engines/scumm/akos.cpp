@@ -549,6 +549,12 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 	bool masked;
 	bool skip_column = false;
 
+	if (!_actorHitMode && _scaleX == 255 && _scaleY == 255 && _shadow_mode != 2 &&
+	    _vm->_bytesPerPixel == 1 && !(_vm->_game.features & GF_16BIT_COLOR)) {
+		codec1_unscaledDecode(v1);
+		return;
+	}
+
 	y = v1.y;
 	src = _srcptr;
 	dst = v1.destptr;
@@ -637,6 +643,94 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 	} while (1);
 }
 
+// Unscaled 8bpp variant of codec1_genericDecode(). Every decoded pixel maps to
+// exactly one output row, so each run is clipped once and then drawn down the
+// column as a whole. Shadows are resolved per run into a remap table, since
+// the costume color is constant over a run.
+void AkosRenderer::codec1_unscaledDecode(Codec1 &v1) {
+	const byte *mask, *src;
+	byte *dst;
+	const byte *table;
+	byte maskbit;
+	int y, len, height, n;
+	uint16 color, pcolor;
+	bool visible;
+
+	y = v1.y;
+	src = _srcptr;
+	dst = v1.destptr;
+	len = v1.replen;
+	color = v1.repcolor;
+	height = _height;
+
+	maskbit = revBitMask(v1.x & 7);
+	mask = _vm->getMaskBuffer(v1.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), v1.y, _zbuf);
+	visible = (v1.x >= 0 && v1.x < v1.boundsRect.right);
+
+	// codec1_ignorePakCols() already consumed the first pixel of a
+	// pending run.
+	if (len)
+		len--;
+
+	do {
+		while (len) {
+			n = MIN(len, height);
+
+			if (color && visible) {
+				pcolor = _palette[color];
+				table = 0;
+				if (_shadow_mode == 1) {
+					if (pcolor == 13)
+						table = _shadow_table;
+				} else if (_shadow_mode == 3) {
+					if (_vm->_game.heversion >= 90)
+						table = xmap + (pcolor << 8);
+					else if (pcolor < 8)
+						table = _shadow_table + (pcolor << 8);
+				}
+
+				if (table)
+					codec1_drawColumnRun<true, true>(dst, mask, maskbit, y, n, v1.boundsRect.top, v1.boundsRect.bottom, 0, table);
+				else
+					codec1_drawColumnRun<false, true>(dst, mask, maskbit, y, n, v1.boundsRect.top, v1.boundsRect.bottom, pcolor, 0);
+			}
+
+			dst += n * _out.pitch;
+			mask += n * _numStrips;
+			y += n;
+			len -= n;
+			height -= n;
+
+			if (!height) {
+				if (!--v1.skip_width)
+					return;
+				height = _height;
+				y = v1.y;
+
+				v1.x += v1.scaleXstep;
+				if (v1.x < 0 || v1.x >= v1.boundsRect.right)
+					return;
+				visible = true;
+				maskbit = revBitMask(v1.x & 7);
+				v1.destptr += v1.scaleXstep;
+				v1.scaleXindex += v1.scaleXstep;
+				dst = v1.destptr;
+				mask = _vm->getMaskBuffer(v1.x - (_vm->_virtscr[kMainVirtScreen].xstart & 7), v1.y, _zbuf);
+			}
+		}
+
+		len = *src++;
+		color = len >> v1.shr;
+		len &= v1.mask;
+		if (!len)
+			len = *src++;
+		// A zero length byte wraps around in the byte counter of
+		// codec1_genericDecode()
+		if (!len)
+			len = 256;
+	} while (1);
+}
+
 // This is exact duplicate of smallCostumeScaleTable[] in costume.cpp
 // See FIXME below for explanation
 const byte smallCostumeScaleTableAKOS[256] = {
@@ -155,6 +155,41 @@ protected:
 	virtual byte drawLimb(const Actor *a, int limb) = 0;
 
 	void codec1_ignorePakCols(Codec1 &v1, int num);
+
+	/**
+	 * Draw count pixels of one costume run down the current column,
+	 * starting at row y. Only the rows in [top, bottom) which are not
+	 * hidden by the mask are touched. With Translate set the destination
+	 * pixels are remapped through the 256 entry table (shadows), otherwise
+	 * they are filled with color.
+	 */
+	template<bool Translate, bool Masked>
+	void codec1_drawColumnRun(byte *dst, const byte *mask, byte maskbit, int y, int count,
+	                          int top, int bottom, byte color, const byte *table) const {
+		int first = 0, last = count;
+		if (y < top)
+			first = top - y;
+		if (y + last > bottom)
+			last = bottom - y;
+		if (first >= last)
+			return;
+
+		dst += first * _out.pitch;
+		if (Masked)
+			mask += first * _numStrips;
+
+		for (int i = first; i < last; i++) {
+			if (!Masked || !(*mask & maskbit)) {
+				if (Translate)
+					*dst = table[*dst];
+				else
+					*dst = color;
+			}
+			dst += _out.pitch;
+			if (Masked)
+				mask += _numStrips;
+		}
+	}
 };
 
 } // End of namespace Scumm
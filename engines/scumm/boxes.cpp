@@ -191,6 +191,11 @@ byte ScummEngine::getMaskFromBox(int box) {
 void ScummEngine::setBoxFlags(int box, int val) {
 	debug(2, "setBoxFlags(%d, 0x%02x)", box, val);
 
+	// In the old box formats the flags share storage with data which
+	// influences the box coordinates.
+	if (_game.version <= 2)
+		invalidateBoxCache();
+
 	/* SCUMM7+ stuff */
 	if (val & 0xC000) {
 		assert(box >= 0 && box < 65);
@@ -520,24 +525,33 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 	if (boxnum < 0 || boxnum == Actor::kInvalidBox)
 		return false;
 
-	BoxCoords box = getBoxCoordinates(boxnum);
+	const BoxCache *cache = getBoxCache();
 	const Common::Point p(x, y);
+	BoxCoords box;
 
 	// Quick check: If the x (resp. y) coordinate of the point is
 	// strictly smaller (bigger) than the x (y) coordinates of all
 	// corners of the quadrangle, then it certainly is *not* contained
 	// inside the quadrangle.
-	if (x < box.ul.x && x < box.ur.x && x < box.lr.x && x < box.ll.x)
-		return false;
+	if (cache->hasBox(boxnum)) {
+		if (!cache->getBounds(boxnum).contains(p))
+			return false;
+		box = cache->getCoords(boxnum);
+	} else {
+		box = decodeBoxCoordinates(boxnum);
 
-	if (x > box.ul.x && x > box.ur.x && x > box.lr.x && x > box.ll.x)
-		return false;
+		if (x < box.ul.x && x < box.ur.x && x < box.lr.x && x < box.ll.x)
+			return false;
 
-	if (y < box.ul.y && y < box.ur.y && y < box.lr.y && y < box.ll.y)
-		return false;
+		if (x > box.ul.x && x > box.ur.x && x > box.lr.x && x > box.ll.x)
+			return false;
 
-	if (y > box.ul.y && y > box.ur.y && y > box.lr.y && y > box.ll.y)
-		return false;
+		if (y < box.ul.y && y < box.ur.y && y < box.lr.y && y < box.ll.y)
+			return false;
+
+		if (y > box.ul.y && y > box.ur.y && y > box.lr.y && y > box.ll.y)
+			return false;
+	}
 
 	// Corner case: If the box is a simple line segment, we consider the
 	// point to be contained "in" (or rather, lying on) the line if it
@@ -572,6 +586,13 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 }
 
 BoxCoords ScummEngine::getBoxCoordinates(int boxnum) {
+	const BoxCache *cache = getBoxCache();
+	if (cache->hasBox(boxnum))
+		return cache->getCoords(boxnum);
+	return decodeBoxCoordinates(boxnum);
+}
+
+BoxCoords ScummEngine::decodeBoxCoordinates(int boxnum) {
 	BoxCoords tmp, *box = &tmp;
 	Box *bp = getBoxBaseAddr(boxnum);
 	assert(bp);
@@ -732,6 +753,19 @@ int ScummEngine::getNextBox(byte from, byte to) {
 	assert(from < numOfBoxes);
 	assert(to < numOfBoxes);
 
+	if (_game.version >= 3) {
+		// WORKAROUND: See below for the Indy3 special case.
+		if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
+			return 0;
+
+		const BoxCache *cache = getBoxCache();
+		if (cache->hasItinerary() && cache->hasBox(from) && cache->hasBox(to)) {
+			if (cache->isItineraryTruncated(from))
+				debug(0, "The box matrix apparently is truncated (room %d)", _roomResource);
+			return cache->getItinerary(from, to);
+		}
+	}
+
 	boxm = getBoxMatrixBaseAddr();
 
 	if (_game.version == 0) {
@@ -1063,6 +1097,7 @@ void ScummEngine::createBoxMatrix() {
 	}
 	addToMatrix(0xFF);
 
+	invalidateBoxCache();
 
 #if BOX_DEBUG
 	debug("Itinerary matrix:\n");
@@ -1074,6 +1109,150 @@ void ScummEngine::createBoxMatrix() {
 	free(itineraryMatrix);
 }
 
+BoxCache::BoxCache()
+	: _valid(false), _boxesAddress(0), _matrixAddress(0), _numBoxes(0),
+	  _hasItinerary(false), _gridWidth(0), _gridHeight(0) {
+}
+
+void BoxCache::reset(const byte *boxes, const byte *matrix, int numBoxes) {
+	_valid = false;
+	_boxesAddress = boxes;
+	_matrixAddress = matrix;
+	_numBoxes = numBoxes;
+	_hasItinerary = false;
+
+	_coords.resize(numBoxes);
+	_bounds.resize(numBoxes);
+	_itinerary.resize(numBoxes * numBoxes);
+	for (uint i = 0; i < _itinerary.size(); i++)
+		_itinerary[i] = -1;
+	_truncated.resize(numBoxes);
+	for (uint i = 0; i < _truncated.size(); i++)
+		_truncated[i] = false;
+}
+
+void BoxCache::setBox(int box, const BoxCoords &coords) {
+	_coords[box] = coords;
+
+	Common::Rect &r = _bounds[box];
+	r.left = MIN(MIN(coords.ul.x, coords.ur.x), MIN(coords.ll.x, coords.lr.x));
+	r.top = MIN(MIN(coords.ul.y, coords.ur.y), MIN(coords.ll.y, coords.lr.y));
+	r.right = MAX(MAX(coords.ul.x, coords.ur.x), MAX(coords.ll.x, coords.lr.x)) + 1;
+	r.bottom = MAX(MAX(coords.ul.y, coords.ur.y), MAX(coords.ll.y, coords.lr.y)) + 1;
+}
+
+void BoxCache::finish(bool hasItinerary) {
+	_hasItinerary = hasItinerary;
+	_grid.clear();
+	_gridWidth = _gridHeight = 0;
+
+	if (_numBoxes > 0 && _numBoxes <= 256) {
+		_gridArea = _bounds[0];
+		for (int i = 1; i < _numBoxes; i++)
+			_gridArea.extend(_bounds[i]);
+
+		_gridWidth = ((_gridArea.width() - 1) >> kCellShift) + 1;
+		_gridHeight = ((_gridArea.height() - 1) >> kCellShift) + 1;
+
+		// Broken box data can span huge areas, don't bother with a grid then
+		if (_gridWidth * _gridHeight <= 4096) {
+			_grid.resize(_gridWidth * _gridHeight * 8);
+			for (uint i = 0; i < _grid.size(); i++)
+				_grid[i] = 0;
+
+			for (int i = 0; i < _numBoxes; i++) {
+				const Common::Rect &r = _bounds[i];
+				int x1 = (r.left - _gridArea.left) >> kCellShift;
+				int x2 = (r.right - 1 - _gridArea.left) >> kCellShift;
+				int y1 = (r.top - _gridArea.top) >> kCellShift;
+				int y2 = (r.bottom - 1 - _gridArea.top) >> kCellShift;
+
+				for (int y = y1; y <= y2; y++)
+					for (int x = x1; x <= x2; x++)
+						_grid[(y * _gridWidth + x) * 8 + (i >> 5)] |= 1U << (i & 31);
+			}
+		} else {
+			_gridWidth = _gridHeight = 0;
+		}
+	}
+
+	_valid = true;
+}
+
+void BoxCache::findBoxesNear(const Common::Rect &area, uint32 boxes[8]) const {
+	if (_grid.empty()) {
+		for (int i = 0; i < MIN(_numBoxes, 256); i++)
+			boxes[i >> 5] |= 1U << (i & 31);
+		return;
+	}
+
+	Common::Rect r(area);
+	r.clip(_gridArea);
+	if (r.isEmpty())
+		return;
+
+	int x1 = (r.left - _gridArea.left) >> kCellShift;
+	int x2 = (r.right - 1 - _gridArea.left) >> kCellShift;
+	int y1 = (r.top - _gridArea.top) >> kCellShift;
+	int y2 = (r.bottom - 1 - _gridArea.top) >> kCellShift;
+
+	for (int y = y1; y <= y2; y++) {
+		for (int x = x1; x <= x2; x++) {
+			const uint32 *cell = &_grid[(y * _gridWidth + x) * 8];
+			for (int i = 0; i < 8; i++)
+				boxes[i] |= cell[i];
+		}
+	}
+}
+
+const BoxCache *ScummEngine::getBoxCache() {
+	// Compare the resource addresses directly, going through
+	// getResourceAddress() would cost more than the cache saves.
+	const byte *boxes = _res->_types[rtMatrix][2]._address;
+	const byte *matrix = _res->_types[rtMatrix][1]._address;
+
+	if (!_boxCache->isValid(boxes, matrix))
+		rebuildBoxCache(boxes, matrix);
+	return _boxCache;
+}
+
+void ScummEngine::invalidateBoxCache() {
+	_boxCache->invalidate();
+}
+
+void ScummEngine::rebuildBoxCache(const byte *boxes, const byte *matrix) {
+	const int numOfBoxes = boxes ? getNumBoxes() : 0;
+	int from, to;
+
+	_boxCache->reset(boxes, matrix, numOfBoxes);
+
+	for (int i = 0; i < numOfBoxes; i++)
+		_boxCache->setBox(i, decodeBoxCoordinates(i));
+
+	// Unpack the box matrix in the format described in createBoxMatrix(),
+	// exactly as getNextBox() would walk it: later entries of a row win,
+	// and a truncated matrix simply ends the search.
+	bool hasItinerary = false;
+	if (_game.version >= 3 && matrix) {
+		const byte *boxm = getBoxMatrixBaseAddr();
+		const byte *end = boxm + getResourceSize(rtMatrix, 1);
+
+		for (from = 0; from < numOfBoxes; from++) {
+			while (boxm < end && boxm[0] != 0xFF) {
+				for (to = boxm[0]; to <= boxm[1] && to < numOfBoxes; to++)
+					_boxCache->setItinerary(from, to, (int8)boxm[2]);
+				boxm += 3;
+			}
+			if (boxm >= end)
+				_boxCache->setItineraryTruncated(from);
+			boxm++;
+		}
+		hasItinerary = true;
+	}
+
+	_boxCache->finish(hasItinerary);
+}
+
 /** Check if two boxes are neighbors. */
 bool ScummEngine::areBoxesNeighbors(int box1nr, int box2nr) {
 	Common::Point tmp;
@@ -23,6 +23,7 @@
 #ifndef SCUMM_BOXES_H
 #define SCUMM_BOXES_H
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -51,6 +52,72 @@ struct BoxCoords {			/* Box coordinates */
 
 int getClosestPtOnBox(const BoxCoords &box, int x, int y, int16& outX, int16& outY);
 
+/**
+ * Decoded walkbox data of the current room.
+ *
+ * Walkboxes are stored in the room resources in a version specific format,
+ * and the box matrix in a run length compressed form. Both are consulted
+ * many times per frame for every walking actor, so the box corners, their
+ * bounding rectangles and the itinerary (next box on the way from one box
+ * to another) are decoded once here and kept until the room data changes.
+ * In addition, a coarse grid over the room records which boxes overlap
+ * each cell, to quickly find the boxes near a given point.
+ */
+class BoxCache {
+public:
+	BoxCache();
+
+	void invalidate() { _valid = false; }
+	bool isValid(const byte *boxes, const byte *matrix) const {
+		return _valid && _boxesAddress == boxes && _matrixAddress == matrix;
+	}
+
+	/** Start a rebuild for the given room data with numBoxes boxes. */
+	void reset(const byte *boxes, const byte *matrix, int numBoxes);
+	void setBox(int box, const BoxCoords &coords);
+	/** Set the next box on the way from box 'from' to box 'to'. */
+	void setItinerary(int from, int to, int next) { _itinerary[from * _numBoxes + to] = next; }
+	void setItineraryTruncated(int from) { _truncated[from] = true; }
+	/** Complete the rebuild, hasItinerary tells whether setItinerary() was used. */
+	void finish(bool hasItinerary);
+
+	bool hasBox(int box) const { return box >= 0 && box < _numBoxes; }
+	const BoxCoords &getCoords(int box) const { return _coords[box]; }
+	const Common::Rect &getBounds(int box) const { return _bounds[box]; }
+
+	bool hasItinerary() const { return _hasItinerary; }
+	int getItinerary(int from, int to) const { return _itinerary[from * _numBoxes + to]; }
+	bool isItineraryTruncated(int from) const { return _truncated[from]; }
+
+	/**
+	 * Mark all boxes whose bounding rectangle may intersect the given
+	 * area in the 256 bit set 'boxes'. This is a superset of the boxes
+	 * actually intersecting the area.
+	 */
+	void findBoxesNear(const Common::Rect &area, uint32 boxes[8]) const;
+
+private:
+	enum {
+		kCellShift = 5
+	};
+
+	bool _valid;
+	const byte *_boxesAddress;
+	const byte *_matrixAddress;
+	int _numBoxes;
+
+	Common::Array<BoxCoords> _coords;
+	Common::Array<Common::Rect> _bounds;
+
+	bool _hasItinerary;
+	Common::Array<int8> _itinerary;
+	Common::Array<bool> _truncated;
+
+	Common::Rect _gridArea;
+	int _gridWidth, _gridHeight;
+	Common::Array<uint32> _grid;	// 8 words per cell
+};
+
 } // End of namespace Scumm
 
 #endif
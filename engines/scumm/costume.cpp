@@ -455,6 +455,14 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 	}
 #endif /* USE_ARM_COSTUME_ASM */
 
+	if (_scaleX == 255 && _scaleY == 255) {
+		if (v1.mask_ptr)
+			proc3_unscaled<true>(v1);
+		else
+			proc3_unscaled<false>(v1);
+		return;
+	}
+
 	y = v1.y;
 	src = _srcptr;
 	dst = v1.destptr;
@@ -518,6 +526,83 @@ void ClassicCostumeRenderer::proc3(Codec1 &v1) {
 	} while (1);
 }
 
+// Unscaled variant of proc3(). Without scaling every decoded pixel maps to
+// exactly one output row, so each run can be clipped once and drawn down the
+// column in one go instead of re-checking bounds, mask and shadow per pixel.
+template<bool Masked>
+void ClassicCostumeRenderer::proc3_unscaled(Codec1 &v1) {
+	const byte *mask, *src;
+	byte *dst;
+	byte maskbit;
+	int y, len, height, n;
+	uint color, pcolor;
+	bool visible;
+
+	y = v1.y;
+	src = _srcptr;
+	dst = v1.destptr;
+	len = v1.replen;
+	color = v1.repcolor;
+	height = _height;
+
+	maskbit = revBitMask(v1.x & 7);
+	mask = Masked ? v1.mask_ptr + v1.x / 8 : 0;
+	visible = (v1.x >= 0 && v1.x < _out.w);
+
+	// codec1_ignorePakCols() already consumed the first pixel of a
+	// pending run.
+	if (len)
+		len--;
+
+	do {
+		while (len) {
+			n = MIN(len, height);
+
+			if (color && visible) {
+				pcolor = _palette[color];
+				if ((_shadow_mode & 0x20) || (pcolor == 13 && _shadow_table))
+					codec1_drawColumnRun<true, Masked>(dst, mask, maskbit, y, n, 0, _out.h, 0, _shadow_table);
+				else
+					codec1_drawColumnRun<false, Masked>(dst, mask, maskbit, y, n, 0, _out.h, pcolor, 0);
+			}
+
+			dst += n * _out.pitch;
+			if (Masked)
+				mask += n * _numStrips;
+			y += n;
+			len -= n;
+			height -= n;
+
+			if (!height) {
+				if (!--v1.skip_width)
+					return;
+				height = _height;
+				y = v1.y;
+
+				v1.x += v1.scaleXstep;
+				if (v1.x < 0 || v1.x >= _out.w)
+					return;
+				visible = true;
+				maskbit = revBitMask(v1.x & 7);
+				v1.destptr += v1.scaleXstep;
+				_scaleIndexX += v1.scaleXstep;
+				dst = v1.destptr;
+				if (Masked)
+					mask = v1.mask_ptr + v1.x / 8;
+			}
+		}
+
+		len = *src++;
+		color = len >> v1.shr;
+		len &= v1.mask;
+		if (!len)
+			len = *src++;
+		// A zero length byte wraps around in the byte counter of proc3()
+		if (!len)
+			len = 256;
+	} while (1);
+}
+
 void ClassicCostumeRenderer::proc3_ami(Codec1 &v1) {
 	const byte *mask, *src;
 	byte *dst;
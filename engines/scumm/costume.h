@@ -99,6 +99,8 @@ protected:
 	byte drawLimb(const Actor *a, int limb);
 
 	void proc3(Codec1 &v1);
+	template<bool Masked>
+	void proc3_unscaled(Codec1 &v1);
 	void proc3_ami(Codec1 &v1);
 
 	void procC64(Codec1 &v1, int actor);
@@ -32,6 +32,8 @@
 #include "scumm/imuse/imuse.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
+#include "scumm/script_profiler.h"
+#include "scumm/snapshot.h"
 #include "scumm/scumm.h"
 #include "scumm/sound.h"
 
@@ -69,6 +71,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 
 	registerCmd("actor",     WRAP_METHOD(ScummDebugger, Cmd_Actor));
 	registerCmd("actors",    WRAP_METHOD(ScummDebugger, Cmd_PrintActor));
+	registerCmd("costumebench", WRAP_METHOD(ScummDebugger, Cmd_CostumeBench));
 	registerCmd("box",       WRAP_METHOD(ScummDebugger, Cmd_PrintBox));
 	registerCmd("matrix",    WRAP_METHOD(ScummDebugger, Cmd_PrintBoxMatrix));
 	registerCmd("camera",    WRAP_METHOD(ScummDebugger, Cmd_Camera));
@@ -78,6 +81,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 	registerCmd("script",    WRAP_METHOD(ScummDebugger, Cmd_Script));
 	registerCmd("scr",       WRAP_METHOD(ScummDebugger, Cmd_Script));
 	registerCmd("scripts",   WRAP_METHOD(ScummDebugger, Cmd_PrintScript));
+	registerCmd("scriptprof", WRAP_METHOD(ScummDebugger, Cmd_ScriptProfiler));
 	registerCmd("importres", WRAP_METHOD(ScummDebugger, Cmd_ImportRes));
 
 	if (_vm->_game.id == GID_LOOM)
@@ -88,6 +92,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 
 	registerCmd("loadgame",  WRAP_METHOD(ScummDebugger, Cmd_LoadGame));
 	registerCmd("savegame",  WRAP_METHOD(ScummDebugger, Cmd_SaveGame));
+	registerCmd("snapshot",  WRAP_METHOD(ScummDebugger, Cmd_Snapshot));
 
 	registerCmd("debug",     WRAP_METHOD(ScummDebugger, Cmd_Debug));
 
@@ -215,6 +220,44 @@ bool ScummDebugger::Cmd_SaveGame(int argc, const char **argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_Snapshot(int argc, const char **argv) {
+	if (argc > 1 && !strcmp(argv[1], "take")) {
+		_vm->requestSnapshot();
+		debugPrintf("Snapshot will be taken on the next frame\n");
+	} else if (argc > 2 && !strcmp(argv[1], "restore")) {
+		uint back = atoi(argv[2]);
+		if (back >= _vm->_snapshots.size()) {
+			debugPrintf("No such snapshot\n");
+			return true;
+		}
+		_vm->requestSnapshotLoad(back);
+
+		detach();
+		return false;
+	} else if (argc > 3 && !strcmp(argv[1], "write")) {
+		if (!_vm->writeSnapshot(atoi(argv[2]), atoi(argv[3])))
+			debugPrintf("Failed to write snapshot\n");
+	} else if (argc > 1 && !strcmp(argv[1], "clear")) {
+		_vm->clearSnapshots();
+	} else if (argc == 1 || !strcmp(argv[1], "list")) {
+		uint32 now = g_system->getMillis();
+		uint32 total = 0;
+
+		for (uint i = 0; i < _vm->_snapshots.size(); i++) {
+			const SaveSnapshot *snapshot = _vm->_snapshots[_vm->_snapshots.size() - 1 - i];
+			debugPrintf("%2d: %5ds ago, %8d bytes, %8d bytes copied, %d of %d resources shared\n", i,
+			            (now - snapshot->getCreationTime()) / 1000, snapshot->getSize(), snapshot->getCopiedSize(),
+			            snapshot->getSharedResources(), snapshot->getNumResources());
+			total += snapshot->getCopiedSize();
+		}
+		debugPrintf("%d snapshots, %d bytes in use\n", _vm->_snapshots.size(), total);
+	} else {
+		debugPrintf("Syntax: snapshot <list|take|restore <n>|write <n> <slotnum>|clear>\n");
+	}
+
+	return true;
+}
+
 bool ScummDebugger::Cmd_Show(int argc, const char **argv) {
 
 	if (argc != 2) {
@@ -281,6 +324,82 @@ bool ScummDebugger::Cmd_Script(int argc, const char** argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_ScriptProfiler(int argc, const char **argv) {
+	ScriptProfiler *prof = _vm->_scriptProfiler;
+
+	if (argc < 2) {
+		debugPrintf("Script profiler is %s\n", prof ? "on" : "off");
+		debugPrintf("Usage: scriptprof <on|off|reset|show [<count>]|csv <file>|flame <file>>\n");
+		return true;
+	}
+
+	if (!strcmp(argv[1], "on")) {
+		if (!prof)
+			_vm->_scriptProfiler = new ScriptProfiler(_vm);
+		debugPrintf("Script profiler enabled\n");
+		return true;
+	}
+
+	if (!prof) {
+		debugPrintf("Script profiler is not enabled, use 'scriptprof on'\n");
+		return true;
+	}
+
+	if (!strcmp(argv[1], "off")) {
+		delete prof;
+		_vm->_scriptProfiler = 0;
+		debugPrintf("Script profiler disabled\n");
+	} else if (!strcmp(argv[1], "reset")) {
+		prof->reset();
+	} else if (!strcmp(argv[1], "show")) {
+		int count = (argc > 2) ? atoi(argv[2]) : 20;
+		if (count <= 0) {
+			debugPrintf("Invalid count '%s'\n", argv[2]);
+			return true;
+		}
+		uint32 total = prof->getTotalOpcodes();
+
+		debugPrintf("%u opcodes executed\n\n", total);
+		debugPrintf("+------+--------+----+----+--------+----------+--------+\n");
+		debugPrintf("|script| where  |room|slot|  runs  | opcodes  |   ms   |\n");
+		debugPrintf("+------+--------+----+----+--------+----------+--------+\n");
+		Common::Array<ScriptProfiler::ScriptStats> list = prof->getSortedStats();
+		for (uint i = 0; i < list.size() && i < (uint)count; i++) {
+			const ScriptProfiler::ScriptStats &st = list[i];
+			debugPrintf("|%6d|%-8s|%4d|%4d|%8u|%10u|%8u|\n", st.number, ScriptProfiler::getWhereName(st.where),
+			            st.room, st.lastSlot, st.runs, st.opcodes, st.millis);
+		}
+		debugPrintf("+------+--------+----+----+--------+----------+--------+\n\n");
+
+		// Opcode histogram, most frequent first
+		byte order[256];
+		for (int i = 0; i < 256; i++)
+			order[i] = i;
+		for (int i = 1; i < 256; i++) {
+			for (int j = i; j > 0 && prof->getOpcodeCount(order[j]) > prof->getOpcodeCount(order[j - 1]); j--)
+				SWAP(order[j], order[j - 1]);
+		}
+		for (uint i = 0; i < MIN<uint>(count, 256) && prof->getOpcodeCount(order[i]); i++) {
+			uint32 num = prof->getOpcodeCount(order[i]);
+			debugPrintf("[%02X] %-28s %10u %5.1f%%\n", order[i], _vm->getOpcodeDesc(order[i]), num, 100.0 * num / total);
+		}
+	} else if (!strcmp(argv[1], "csv") && argc > 2) {
+		if (prof->dumpCSV(argv[2]))
+			debugPrintf("Wrote script statistics to '%s'\n", argv[2]);
+		else
+			debugPrintf("Could not write '%s'\n", argv[2]);
+	} else if (!strcmp(argv[1], "flame") && argc > 2) {
+		if (prof->dumpFolded(argv[2]))
+			debugPrintf("Wrote folded script stacks to '%s'\n", argv[2]);
+		else
+			debugPrintf("Could not write '%s'\n", argv[2]);
+	} else {
+		debugPrintf("Unknown scriptprof command '%s'\n", argv[1]);
+	}
+
+	return true;
+}
+
 bool ScummDebugger::Cmd_ImportRes(int argc, const char** argv) {
 	Common::File file;
 	uint32 size;
@@ -428,6 +547,46 @@ bool ScummDebugger::Cmd_PrintActor(int argc, const char **argv) {
 	return true;
 }
 
+bool ScummDebugger::Cmd_CostumeBench(int argc, const char **argv) {
+	int iterations = (argc > 1) ? atoi(argv[1]) : 100;
+	int i, j, numDrawn = 0;
+	uint32 total = 0;
+	Actor *a;
+
+	if (iterations <= 0) {
+		debugPrintf("Usage: costumebench [<iterations>]\n");
+		return true;
+	}
+
+	debugPrintf("Drawing every visible actor in room %d %d times\n", _vm->_currentRoom, iterations);
+	debugPrintf("+--+---+---+---+-----------+\n");
+	debugPrintf("|# |cos|scl|shd| ms total  |\n");
+	debugPrintf("+--+---+---+---+-----------+\n");
+	for (i = 1; i < _vm->_numActors; i++) {
+		a = _vm->_actors[i];
+		if (!a->isInCurrentRoom() || !a->_visible || !a->_costume)
+			continue;
+
+		uint32 start = g_system->getMillis();
+		for (j = 0; j < iterations; j++) {
+			a->_needRedraw = true;
+			a->drawActorCostume();
+		}
+		uint32 elapsed = g_system->getMillis() - start;
+
+		debugPrintf("|%2d|%3d|%3d|%3d|%11u|\n", a->_number, a->_costume, a->_scalex, a->_shadowMode, elapsed);
+		total += elapsed;
+		numDrawn++;
+	}
+	debugPrintf("+--+---+---+---+-----------+\n");
+	if (numDrawn)
+		debugPrintf("%d actors, %u ms total, %.3f ms per frame\n", numDrawn, total, (double)total / iterations);
+
+	// Repeated drawing accumulates shadows, so redraw the room afterwards
+	_vm->_fullRedraw = true;
+	return true;
+}
+
 bool ScummDebugger::Cmd_PrintObjects(int argc, const char **argv) {
 	int i;
 	ObjectData *o;
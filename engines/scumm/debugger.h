@@ -44,9 +44,11 @@ private:
 	bool Cmd_Room(int argc, const char **argv);
 	bool Cmd_LoadGame(int argc, const char **argv);
 	bool Cmd_SaveGame(int argc, const char **argv);
+	bool Cmd_Snapshot(int argc, const char **argv);
 	bool Cmd_Restart(int argc, const char **argv);
 
 	bool Cmd_PrintActor(int argc, const char **argv);
+	bool Cmd_CostumeBench(int argc, const char **argv);
 	bool Cmd_PrintBox(int argc, const char **argv);
 	bool Cmd_PrintBoxMatrix(int argc, const char **argv);
 	bool Cmd_PrintObjects(int argc, const char **argv);
@@ -55,6 +57,7 @@ private:
 	bool Cmd_Object(int argc, const char **argv);
 	bool Cmd_Script(int argc, const char **argv);
 	bool Cmd_PrintScript(int argc, const char **argv);
+	bool Cmd_ScriptProfiler(int argc, const char **argv);
 	bool Cmd_ImportRes(int argc, const char **argv);
 
 	bool Cmd_PrintDraft(int argc, const char **argv);
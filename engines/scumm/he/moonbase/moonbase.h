@@ -25,6 +25,8 @@
 
 #ifdef ENABLE_HE
 
+#include "common/array.h"
+#include "common/rect.h"
 #include "common/winexe_pe.h"
 
 namespace Scumm {
@@ -63,6 +65,10 @@ public:
 
 private:
 	int readFOWVisibilityArray(int array, int y, int x);
+	void resetFOWTiles(int fowInfoArray, int downDim, int acrossDim);
+	void markFOWTileDirty(int y, int x);
+	uint32 computeFOWTileState(int y, int x) const;
+	void buildFOWCommands();
 	void renderFOWState(uint8 *destSurface, int dstPitch, int dstType, int dstw, int dsth, int x, int y, int srcw, int srch, int state, int flags);
 
 public:
@@ -100,7 +106,25 @@ private:
 
 	bool _fowBlackMode;
 
-	int32 _fowRenderTable[32768];
+	// Visibility array as last read, the derived render state of every
+	// tile and a bitmap of the tiles whose state needs to be recomputed
+	int _fowInfoArray;
+	int _fowDownDim;
+	int _fowAcrossDim;
+	Common::Array<byte> _fowVisibility;
+	Common::Array<uint32> _fowTileStates;
+	Common::Array<uint32> _fowDirtyTiles;
+
+	struct FOWCommand {
+		int x1, y1, x2, y2;
+		int state;
+	};
+
+	// Draw list for renderFOW(), rebuilt only when a visible tile changes
+	Common::Array<FOWCommand> _fowCommands;
+	bool _fowCommandsValid;
+
+	Common::Array<Common::Point> _fowStateSpots;
 
 	Common::PEResources _exe;
 	Common::String _fileName;
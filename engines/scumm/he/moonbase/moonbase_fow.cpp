@@ -59,7 +59,11 @@ void Moonbase::initFOW() {
 
 	_fowBlackMode = true;
 
-	memset(_fowRenderTable, 0, sizeof(_fowRenderTable));
+	_fowInfoArray = 0;
+	_fowDownDim = 0;
+	_fowAcrossDim = 0;
+
+	_fowCommandsValid = false;
 }
 
 void Moonbase::releaseFOWResources() {
@@ -67,6 +71,10 @@ void Moonbase::releaseFOWResources() {
 		free(_fowImage);
 		_fowImage = 0;
 	}
+
+	_fowStateSpots.clear();
+	_fowCommands.clear();
+	_fowCommandsValid = false;
 }
 
 bool Moonbase::setFOWImage(int image) {
@@ -142,6 +150,16 @@ bool Moonbase::setFOWImage(int image) {
 	if (ConfMan.hasKey("EnableFOWRects"))
 		_fowBlackMode = (ConfMan.getInt("EnableFOWRects") == 1);
 
+	// Looking up the spot means searching the image blocks, do it once here
+	// instead of for every drawn tile
+	_fowStateSpots.resize(nStates);
+	for (int i = 0; i < nStates; i++) {
+		int32 spotx, spoty;
+
+		_vm->_wiz->getWizImageSpot(_fowImage, i, spotx, spoty);
+		_fowStateSpots[i] = Common::Point(spotx, spoty);
+	}
+
 	return true;
 }
 
@@ -163,6 +181,18 @@ enum FOWElement {
 	FF_Q_D		= (FF_R | FF_B | FF_B_R)
 };
 
+
+// Tile states, other than solid fog a state holds the four quadrant
+// images (A, B, C, D) of a visible tile bordering the fog, one per byte
+static const uint32 kFOWTileSolid = 0xFFFFFFFF;
+
+static const int kFOWCommandBlack = -1;
+
+static inline int wrapFOWIndex(int i, int dim) {
+	i %= dim;
+	return (i < 0) ? i + dim : i;
+}
+
 int Moonbase::readFOWVisibilityArray(int array, int y, int x) {
 	if (readFromArray(array, x, y) > 0)
 		return FOW_EMPTY;
@@ -170,20 +200,112 @@ int Moonbase::readFOWVisibilityArray(int array, int y, int x) {
 	return FOW_SOLID;
 }
 
+void Moonbase::resetFOWTiles(int fowInfoArray, int downDim, int acrossDim) {
+	const int numTiles = downDim * acrossDim;
+
+	_fowInfoArray = fowInfoArray;
+	_fowDownDim = downDim;
+	_fowAcrossDim = acrossDim;
+
+	// 0xFF never matches a visibility value, so every tile gets read
+	// and computed on first use
+	_fowVisibility.resize(numTiles);
+	for (int i = 0; i < numTiles; i++)
+		_fowVisibility[i] = 0xFF;
+
+	_fowTileStates.resize(numTiles);
+	for (int i = 0; i < numTiles; i++)
+		_fowTileStates[i] = 0;
+
+	_fowDirtyTiles.resize((numTiles + 31) / 32);
+	for (uint i = 0; i < _fowDirtyTiles.size(); i++)
+		_fowDirtyTiles[i] = 0xFFFFFFFF;
+
+	_fowCommandsValid = false;
+}
+
+void Moonbase::markFOWTileDirty(int y, int x) {
+	// The state of a tile depends on its eight neighbours
+	for (int dy = -1; dy <= 1; dy++) {
+		const int row = wrapFOWIndex(y + dy, _fowDownDim) * _fowAcrossDim;
+
+		for (int dx = -1; dx <= 1; dx++) {
+			const int tile = row + wrapFOWIndex(x + dx, _fowAcrossDim);
+			_fowDirtyTiles[tile >> 5] |= 1U << (tile & 31);
+		}
+	}
+}
+
+uint32 Moonbase::computeFOWTileState(int y, int x) const {
+	const int t = wrapFOWIndex(y - 1, _fowDownDim) * _fowAcrossDim;
+	const int m = y * _fowAcrossDim;
+	const int b = wrapFOWIndex(y + 1, _fowDownDim) * _fowAcrossDim;
+	const int l = wrapFOWIndex(x - 1, _fowAcrossDim);
+	const int c = x;
+	const int r = wrapFOWIndex(x + 1, _fowAcrossDim);
+
+	if (_fowVisibility[m + c] != FOW_EMPTY)
+		return kFOWTileSolid;
+
+	uint32 bits = 0;
+
+	if (_fowVisibility[t + l] != 0) bits |= FF_T_L;
+	if (_fowVisibility[t + c] != 0) bits |= FF_T;
+	if (_fowVisibility[t + r] != 0) bits |= FF_T_R;
+	if (_fowVisibility[m + l] != 0) bits |= FF_L;
+	if (_fowVisibility[m + r] != 0) bits |= FF_R;
+	if (_fowVisibility[b + l] != 0) bits |= FF_B_L;
+	if (_fowVisibility[b + c] != 0) bits |= FF_B;
+	if (_fowVisibility[b + r] != 0) bits |= FF_B_R;
+
+	uint32 state = 0;
+
+	// Quadrant (A)
+	if (bits & FF_Q_A) {
+		state |= (
+			((FF_L   & bits) ? 1 : 0) |
+			((FF_T   & bits) ? 2 : 0) |
+			((FF_T_L & bits) ? 4 : 0)
+		) + 0;
+	}
+
+	// Quadrant (B)
+	if (bits & FF_Q_B) {
+		state |= ((
+			((FF_R   & bits) ? 1 : 0) |
+			((FF_T   & bits) ? 2 : 0) |
+			((FF_T_R & bits) ? 4 : 0)
+		) + 8) << 8;
+	}
+
+	// Quadrant (C)
+	if (bits & FF_Q_C) {
+		state |= ((
+			((FF_L   & bits) ? 1 : 0) |
+			((FF_B   & bits) ? 2 : 0) |
+			((FF_B_L & bits) ? 4 : 0)
+		) + 16) << 16;
+	}
+
+	// Quadrant (D)
+	if (bits & FF_Q_D) {
+		state |= ((
+			((FF_R   & bits) ? 1 : 0) |
+			((FF_B   & bits) ? 2 : 0) |
+			((FF_B_R & bits) ? 4 : 0)
+		) + 24) << 24;
+	}
+
+	return state;
+}
+
 void Moonbase::setFOWInfo(int fowInfoArray, int downDim, int acrossDim, int viewX, int viewY, int clipX1,
 				int clipY1, int clipX2, int clipY2, int technique, int nFrame) {
-	if (!_fowImage)
+	if (!_fowImage || downDim <= 0 || acrossDim <= 0)
 		return;
 
-	memset(_fowRenderTable, 0, sizeof(_fowRenderTable));
-
-	_fowDrawX = clipX1;
-	_fowDrawY = clipY1;
-
-	_fowClipX1 = clipX1;
-	_fowClipY1 = clipY1;
-	_fowClipX2 = clipX2;
-	_fowClipY2 = clipY2;
+	if (fowInfoArray != _fowInfoArray || downDim != _fowDownDim || acrossDim != _fowAcrossDim)
+		resetFOWTiles(fowInfoArray, downDim, acrossDim);
 
 	// Figure out the number of tiles are involved
 	int view_W = (clipX2 - clipX1) + 1;
@@ -198,139 +320,162 @@ void Moonbase::setFOWInfo(int fowInfoArray, int downDim, int acrossDim, int view
 	int dlw = dw * tw;
 	int dlh = dh * th;
 
-	_fowMvx = (0 <= viewX) ? (viewX % dlw) : (dlw - (-viewX % dlw));
-	_fowMvy = (0 <= viewY) ? (viewY % dlh) : (dlh - (-viewY % dlh));
-
-	_fowVtx1 = _fowMvx / tw;
-	_fowVty1 = _fowMvy / th;
-
-	_fowVw = (((_fowMvx + view_W + tw - 1) / tw) - _fowVtx1) + 1;
-	_fowVh = (((_fowMvy + view_H + th - 1) / th) - _fowVty1) + 1;
-
-	// Build the connectivity table
-	int t = (_fowVty1 - 1); if (t >= dh) { t = 0; } else if (t < 0) { t = (dh - 1); }
-	int m = (_fowVty1 + 0); if (m >= dh) { m = 0; } else if (m < 0) { m = (dh - 1); }
-	int b = (_fowVty1 + 1); if (b >= dh) { b = 0; } else if (b < 0) { b = (dh - 1); }
-
-	int il = (_fowVtx1 - 1); if (il >= dh) { il = 0; } else if (il < 0) { il = (dw - 1); }
-	int ic = (_fowVtx1 + 0); if (ic >= dh) { ic = 0; } else if (ic < 0) { ic = (dw - 1); }
-	int ir = (_fowVtx1 + 1); if (ir >= dh) { ir = 0; } else if (ir < 0) { ir = (dw - 1); }
-
-	int dataOffset = (_fowVw * 3);
-	int dataOffset2 = (dataOffset * 2);
-	int32 *pOutterRenderTableA = _fowRenderTable;
-	int32 *pOutterRenderTableB = pOutterRenderTableA + dataOffset;
-
-	for (int ay = 0; ay < _fowVh; ay++) {
-		int l = il;
-		int c = ic;
-		int r = ir;
-
-		int32 *pRenderTableA = pOutterRenderTableA;
-		int32 *pRenderTableB = pOutterRenderTableB;
-
-		pOutterRenderTableA += dataOffset2;
-		pOutterRenderTableB += dataOffset2;
-
-		for (int ax = 0; ax < _fowVw; ax++) {
-			int visibility = readFOWVisibilityArray(fowInfoArray, m, c);
-
-			if (visibility == FOW_EMPTY) {
-				uint32 bits = 0;
-
-				if (readFOWVisibilityArray(fowInfoArray, t, l) != 0) bits |= FF_T_L;
-				if (readFOWVisibilityArray(fowInfoArray, t, c) != 0) bits |= FF_T;
-				if (readFOWVisibilityArray(fowInfoArray, t, r) != 0) bits |= FF_T_R;
-				if (readFOWVisibilityArray(fowInfoArray, m, l) != 0) bits |= FF_L;
-				if (readFOWVisibilityArray(fowInfoArray, m, r) != 0) bits |= FF_R;
-				if (readFOWVisibilityArray(fowInfoArray, b, l) != 0) bits |= FF_B_L;
-				if (readFOWVisibilityArray(fowInfoArray, b, c) != 0) bits |= FF_B;
-				if (readFOWVisibilityArray(fowInfoArray, b, r) != 0) bits |= FF_B_R;
-
-				if (bits) {
-					*pRenderTableA++ = 1;
-					*pRenderTableB++ = 1;
-
-					// Quadrant (A)
-					if (bits & FF_Q_A) {
-						*pRenderTableA++ = (
-							((FF_L   & bits) ? 1 : 0) |
-							((FF_T   & bits) ? 2 : 0) |
-							((FF_T_L & bits) ? 4 : 0)
-						) + 0;
-					} else {
-						*pRenderTableA++ = 0;
-					}
+	int mvx = wrapFOWIndex(viewX, dlw);
+	int mvy = wrapFOWIndex(viewY, dlh);
+
+	int vtx1 = mvx / tw;
+	int vty1 = mvy / th;
+
+	int vw = (((mvx + view_W + tw - 1) / tw) - vtx1) + 1;
+	int vh = (((mvy + view_H + th - 1) / th) - vty1) + 1;
+
+	if (mvx != _fowMvx || mvy != _fowMvy || vw != _fowVw || vh != _fowVh ||
+			clipX1 != _fowDrawX || clipY1 != _fowDrawY)
+		_fowCommandsValid = false;
+
+	_fowDrawX = clipX1;
+	_fowDrawY = clipY1;
+
+	_fowClipX1 = clipX1;
+	_fowClipY1 = clipY1;
+	_fowClipX2 = clipX2;
+	_fowClipY2 = clipY2;
+
+	_fowMvx = mvx;
+	_fowMvy = mvy;
+	_fowVtx1 = vtx1;
+	_fowVty1 = vty1;
+	_fowVw = vw;
+	_fowVh = vh;
+
+	// Only the visible tiles and their neighbours are read from the
+	// array. A changed value marks the tiles depending on it as dirty.
+	int y = wrapFOWIndex(vty1 - 1, dh);
+	for (int ay = 0; ay < vh + 2; ay++) {
+		int x = wrapFOWIndex(vtx1 - 1, dw);
+
+		for (int ax = 0; ax < vw + 2; ax++) {
+			byte visibility = readFOWVisibilityArray(fowInfoArray, y, x);
+			byte &old = _fowVisibility[y * dw + x];
+
+			if (visibility != old) {
+				old = visibility;
+				markFOWTileDirty(y, x);
+			}
+
+			if (++x >= dw) { x = 0; }
+		}
+
+		if (++y >= dh) { y = 0; }
+	}
+
+	// Recompute the state of the dirty visible tiles
+	y = vty1;
+	for (int ay = 0; ay < vh; ay++) {
+		int x = vtx1;
+
+		for (int ax = 0; ax < vw; ax++) {
+			const int tile = y * dw + x;
+
+			if (_fowDirtyTiles[tile >> 5] & (1U << (tile & 31))) {
+				_fowDirtyTiles[tile >> 5] &= ~(1U << (tile & 31));
 
-					// Quadrant (B)
-					if (bits & FF_Q_B) {
-						*pRenderTableA++ = (
-							((FF_R   & bits) ? 1 : 0) |
-							((FF_T   & bits) ? 2 : 0) |
-							((FF_T_R & bits) ? 4 : 0)
-						) + 8;
+				uint32 state = computeFOWTileState(y, x);
+				if (state != _fowTileStates[tile]) {
+					_fowTileStates[tile] = state;
+					_fowCommandsValid = false;
+				}
+			}
+
+			if (++x >= dw) { x = 0; }
+		}
+
+		if (++y >= dh) { y = 0; }
+	}
+
+	if (!_fowCommandsValid)
+		buildFOWCommands();
+
+	_fowCurrentFOWFrame = (nFrame >= 0) ? (nFrame % _fowAnimationFrames) : ((-nFrame) % _fowAnimationFrames);
+	_fowFrameBaseNumber = (_fowCurrentFOWFrame * FOW_ANIM_FRAME_COUNT);
+}
+
+void Moonbase::buildFOWCommands() {
+	FOWCommand cmd;
+	int ixPos = ((_fowVtx1 * _fowTileW) - _fowMvx) + _fowDrawX;
+	int yPos = ((_fowVty1 * _fowTileH) - _fowMvy) + _fowDrawY;
+	int halfTileHeight = _fowTileH / 2;
+
+	_fowCommands.clear();
+
+	int y = _fowVty1;
+	for (int ry = 0; ry < _fowVh; ry++) {
+		int real_yPos = yPos;
+
+		// Tiles are drawn in two halves, the upper one with quadrants
+		// A and B, the lower one with quadrants C and D
+		for (int i = 0; i < 2; i++) {
+			int xPos = ixPos;
+			int x = _fowVtx1;
+
+			for (int rx = 0; rx < _fowVw; rx++) {
+				uint32 state = _fowTileStates[y * _fowAcrossDim + x];
+
+				if (state == kFOWTileSolid && _fowBlackMode) {
+					// Join runs of black tiles into a single rectangle
+					if (!_fowCommands.empty() && _fowCommands.back().state == kFOWCommandBlack &&
+							_fowCommands.back().y1 == real_yPos && _fowCommands.back().x2 == xPos - 1) {
+						_fowCommands.back().x2 += _fowTileW;
 					} else {
-						*pRenderTableA++ = 0;
+						cmd.x1 = xPos;
+						cmd.y1 = real_yPos;
+						cmd.x2 = xPos + _fowTileW - 1;
+						cmd.y2 = (real_yPos + halfTileHeight) - 1;
+						cmd.state = kFOWCommandBlack;
+						_fowCommands.push_back(cmd);
 					}
+				} else if (state != 0) {
+					int subStates[2];
 
-					// Quadrant (C)
-					if (bits & FF_Q_C) {
-						*pRenderTableB++ = (
-							((FF_L   & bits) ? 1 : 0) |
-							((FF_B   & bits) ? 2 : 0) |
-							((FF_B_L & bits) ? 4 : 0)
-						) + 16;
+					if (state == kFOWTileSolid) {
+						subStates[0] = i ? 35 : 33;
+						subStates[1] = i ? 36 : 34;
 					} else {
-						*pRenderTableB++ = 0;
+						subStates[0] = (state >> (i * 16)) & 0xFF;
+						subStates[1] = (state >> (i * 16 + 8)) & 0xFF;
 					}
 
-					// Quadrant (D)
-					if (bits & FF_Q_D) {
-						*pRenderTableB++ = (
-							((FF_R   & bits) ? 1 : 0) |
-							((FF_B   & bits) ? 2 : 0) |
-							((FF_B_R & bits) ? 4 : 0)
-						) + 24;
-					} else {
-						*pRenderTableB++ = 0;
+					for (int j = 0; j < 2; j++) {
+						if (subStates[j] != 0) {
+							cmd.x1 = cmd.x2 = xPos;
+							cmd.y1 = cmd.y2 = yPos;
+							cmd.state = subStates[j];
+							_fowCommands.push_back(cmd);
+						}
 					}
-				} else {
-					*pRenderTableA++ = 0;
-					*pRenderTableB++ = 0;
-				}
-			} else {
-				if (_fowBlackMode) {
-					*pRenderTableA++ = 2;
-					*pRenderTableB++ = 2;
-				} else {
-					*pRenderTableA++ = 1;
-					*pRenderTableA++ = 33;
-					*pRenderTableA++ = 34;
-
-					*pRenderTableB++ = 1;
-					*pRenderTableB++ = 35;
-					*pRenderTableB++ = 36;
 				}
-			}
 
-			if (++l >= dw) { l = 0; }
-			if (++c >= dw) { c = 0; }
-			if (++r >= dw) { r = 0; }
+				xPos += _fowTileW;
+				if (++x >= _fowAcrossDim) { x = 0; }
+			}
+			real_yPos += halfTileHeight;
 		}
-
-		if (++t >= dh) { t = 0; }
-		if (++m >= dh) { m = 0; }
-		if (++b >= dh) { b = 0; }
+		yPos += _fowTileH;
+		if (++y >= _fowDownDim) { y = 0; }
 	}
 
-	_fowCurrentFOWFrame = (nFrame >= 0) ? (nFrame % _fowAnimationFrames) : ((-nFrame) % _fowAnimationFrames);
-	_fowFrameBaseNumber = (_fowCurrentFOWFrame * FOW_ANIM_FRAME_COUNT);
+	_fowCommandsValid = true;
 }
 
 void Moonbase::renderFOWState(uint8 *destSurface, int dstPitch, int dstType, int dstw, int dsth, int x, int y, int srcw, int srch, int state, int flags) {
 	int32 spotx, spoty;
 
-	_vm->_wiz->getWizImageSpot(_fowImage, state, spotx, spoty);
+	if (state < (int)_fowStateSpots.size()) {
+		spotx = _fowStateSpots[state].x;
+		spoty = _fowStateSpots[state].y;
+	} else {
+		_vm->_wiz->getWizImageSpot(_fowImage, state, spotx, spoty);
+	}
 	Common::Rect r(_fowClipX1, _fowClipY1, _fowClipX2, _fowClipY2);
 
 	_vm->_wiz->drawWizImageEx(destSurface, _fowImage, 0, dstPitch, dstType, dstw, dsth, x - spotx, y - spoty, srcw, srch, state, &r, flags, 0, 0, 16, 0, 0);
@@ -351,72 +496,23 @@ void Moonbase::renderFOW(uint8 *destSurface, int dstPitch, int dstType, int dstw
 	if (!_fowImage)
 		return;
 
-	const int32 *pOutterRenderTable = _fowRenderTable;
-	int ixPos = ((_fowVtx1 * _fowTileW) - _fowMvx) + _fowDrawX;
-	int yPos = ((_fowVty1 * _fowTileH) - _fowMvy) + _fowDrawY;
-	int dataOffset = _fowVw * 3;
-	int halfTileHeight = _fowTileH / 2;
 	int cx2 = MIN(_fowClipX2, (dstw - 1));
 	int cy2 = MIN(_fowClipY2, (dsth - 1));
 
-	for (int ry = 0; ry < _fowVh; ry++) {
-		int real_yPos = yPos;
-
-		for (int i = 0; i < 2; i++) {
-			const int32 *pRenderTable = pOutterRenderTable;
-			pOutterRenderTable += dataOffset;
-
-			int xPos = ixPos;
-
-			for (int rx = 0; rx < _fowVw; rx++) {
-				int nState = *pRenderTable++;
+	for (uint i = 0; i < _fowCommands.size(); i++) {
+		const FOWCommand &cmd = _fowCommands[i];
 
-				if (nState != 0) {
-					if (nState == 2) {
-						int countLeft = (_fowVw - rx);
-						int count = 0;
+		if (cmd.state == kFOWCommandBlack) {
+			int x1 = MAX(0, cmd.x1);
+			int y1 = MAX(0, cmd.y1);
+			int x2 = MIN(cmd.x2, cx2);
+			int y2 = MIN(cmd.y2, cy2);
 
-						for (; count < countLeft; count++) {
-							if (*(pRenderTable + count) != 2)
-								break;
-
-							pRenderTable++;
-							rx++;
-						}
-						count++;
-
-						int x1 = xPos;
-						int y1 = real_yPos;
-
-						xPos += _fowTileW * count;
-						int x2 = (xPos - 1);
-						int y2 = ((y1 + halfTileHeight) - 1);
-
-						x1 = MAX(0, x1);
-						y1 = MAX(0, y1);
-						x2 = MIN(x2, cx2);
-						y2 = MIN(y2, cy2);
-
-						if ((x2 >= x1) && (y2 >= y1) && (x1 <= _fowClipX2) && (y1 <= _fowClipY2))
-							blackRect_16bpp(destSurface, dstPitch, dstw, dsth, x1, y1, x2, y2);
-					} else {
-						int subState;
-
-						if ((subState = *pRenderTable++) != 0)
-							renderFOWState(destSurface, dstPitch, dstType, dstw, dsth, xPos, yPos, _fowTileW, _fowTileH, (subState + _fowFrameBaseNumber), flags);
-
-						if ((subState = *pRenderTable++) != 0)
-							renderFOWState(destSurface, dstPitch, dstType, dstw, dsth, xPos, yPos, _fowTileW, _fowTileH, (subState + _fowFrameBaseNumber), flags);
-
-						xPos += _fowTileW;
-					}
-				} else {
-					xPos += _fowTileW;
-				}
-			}
-			real_yPos += halfTileHeight;
+			if ((x2 >= x1) && (y2 >= y1) && (x1 <= _fowClipX2) && (y1 <= _fowClipY2))
+				blackRect_16bpp(destSurface, dstPitch, dstw, dsth, x1, y1, x2, y2);
+		} else {
+			renderFOWState(destSurface, dstPitch, dstType, dstw, dsth, cmd.x1, cmd.y1, _fowTileW, _fowTileH, cmd.state + _fowFrameBaseNumber, flags);
 		}
-		yPos += _fowTileH;
 	}
 }
 
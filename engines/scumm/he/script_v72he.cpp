@@ -156,7 +156,7 @@ int ScummEngine_v72he::readArray(int array, int idx2, int idx1) {
 	if (readVar(array) == 0)
 		error("readArray: Reference to zeroed array pointer");
 
-	ArrayHeader *ah = (ArrayHeader *)getResourceAddress(rtString, readVar(array));
+	const ArrayHeader *ah = (const ArrayHeader *)getResourceAddressForReading(rtString, readVar(array));
 
 	if (!ah)
 		error("readArray: invalid array %d (%d)", array, readVar(array));
@@ -194,6 +194,7 @@ void ScummEngine::clearOwnerOf(int obj) {
 						_res->_types[rtInventory][i]._size = _res->_types[rtInventory][i + 1]._size;
 						_res->_types[rtInventory][i + 1]._address = NULL;
 						_res->_types[rtInventory][i + 1]._size = 0;
+						_res->setWritten(rtInventory, i);
 					}
 				}
 				break;
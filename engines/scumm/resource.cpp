@@ -727,6 +727,14 @@ int ScummEngine::getResourceSize(ResType type, ResId idx) {
 }
 
 byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
+	return lookupResourceAddress(type, idx, true);
+}
+
+const byte *ScummEngine::getResourceAddressForReading(ResType type, ResId idx) {
+	return lookupResourceAddress(type, idx, false);
+}
+
+byte *ScummEngine::lookupResourceAddress(ResType type, ResId idx, bool forWriting) {
 	byte *ptr;
 
 	if (_game.heversion >= 80 && type == rtString)
@@ -748,6 +756,10 @@ byte *ScummEngine::getResourceAddress(ResType type, ResId idx) {
 
 	_res->setResourceCounter(type, idx, 1);
 
+	// Savegame snapshots need to know which runtime data may change
+	if (forWriting && _res->_types[type]._mode == kDynamicResTypeMode)
+		_res->setWritten(type, idx);
+
 	debugC(DEBUG_RESOURCE, "getResourceAddress(%s,%d) == %p", nameOfResType(type), idx, (void *)ptr);
 	return ptr;
 }
@@ -833,6 +845,7 @@ byte *ResourceManager::createResource(ResType type, ResId idx, uint32 size) {
 
 	_types[type][idx]._address = ptr;
 	_types[type][idx]._size = size;
+	_types[type][idx]._writeStamp = _writeCounter;
 	setResourceCounter(type, idx, 1);
 	return ptr;
 }
@@ -844,6 +857,7 @@ ResourceManager::Resource::Resource() {
 	_status = 0;
 	_roomno = 0;
 	_roomoffs = 0;
+	_writeStamp = 0;
 }
 
 ResourceManager::Resource::~Resource() {
@@ -872,6 +886,7 @@ ResourceManager::ResourceManager(ScummEngine *vm) : _vm(vm) {
 	_maxHeapThreshold = 0;
 	_minHeapThreshold = 0;
 	_expireCounter = 0;
+	_writeCounter = 1;
 }
 
 ResourceManager::~ResourceManager() {
@@ -1006,6 +1021,18 @@ void ResourceManager::setOnHeap(ResType type, ResId idx) {
 	_types[type][idx].setOnHeap();
 }
 
+void ResourceManager::setWritten(ResType type, ResId idx) {
+	if (!validateResource("setWritten", type, idx))
+		return;
+	_types[type][idx]._writeStamp = _writeCounter;
+}
+
+bool ResourceManager::isWrittenSince(ResType type, ResId idx, uint32 stamp) const {
+	if (!validateResource("isWrittenSince", type, idx))
+		return false;
+	return _types[type][idx]._writeStamp > stamp;
+}
+
 bool ResourceManager::isModified(ResType type, ResId idx) const {
 	if (!validateResource("isModified", type, idx))
 		return false;
@@ -126,6 +126,12 @@ public:
 		 */
 		uint32 _roomoffs;
 
+		/**
+		 * The write stamp of the resource manager at the last time the
+		 * data of this resource may have been changed.
+		 */
+		uint32 _writeStamp;
+
 	public:
 		Resource();
 		~Resource();
@@ -175,6 +181,7 @@ protected:
 	uint32 _allocatedSize;
 	uint32 _maxHeapThreshold, _minHeapThreshold;
 	byte _expireCounter;
+	uint32 _writeCounter;
 
 public:
 	ResourceManager(ScummEngine *vm);
@@ -203,6 +210,24 @@ public:
 	void setOffHeap(ResType type, ResId idx);
 	void setOnHeap(ResType type, ResId idx);
 
+	/**
+	 * Note that the data of the specified resource may change. Dynamic
+	 * resources are marked whenever their address is handed out.
+	 */
+	void setWritten(ResType type, ResId idx);
+
+	/**
+	 * Check whether the specified resource may have changed after the
+	 * given stamp was returned by newWriteStamp().
+	 */
+	bool isWrittenSince(ResType type, ResId idx, uint32 stamp) const;
+
+	/**
+	 * Return a new write stamp. Resources marked as written from now on
+	 * compare as written since this stamp.
+	 */
+	uint32 newWriteStamp() { return _writeCounter++; }
+
 	/**
 	 * This method increments the _expireCounter, and if it overflows (which happens
 	 * after at most 256 calls), it calls increaseResourceCounter.
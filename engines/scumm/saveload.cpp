@@ -37,6 +37,7 @@
 #include "scumm/saveload.h"
 #include "scumm/scumm_v0.h"
 #include "scumm/scumm_v7.h"
+#include "scumm/snapshot.h"
 #include "scumm/sound.h"
 #include "scumm/he/sprite_he.h"
 #include "scumm/verbs.h"
@@ -141,6 +142,7 @@ bool ScummEngine::canSaveGameStateCurrently() {
 void ScummEngine::requestSave(int slot, const Common::String &name) {
 	_saveLoadSlot = slot;
 	_saveTemporaryState = false;
+	_saveLoadSnapshot = false;
 	_saveLoadFlag = 1;		// 1 for save
 	_saveLoadDescription = name;
 }
@@ -148,9 +150,25 @@ void ScummEngine::requestSave(int slot, const Common::String &name) {
 void ScummEngine::requestLoad(int slot) {
 	_saveLoadSlot = slot;
 	_saveTemporaryState = (slot == 100);
+	_saveLoadSnapshot = false;
 	_saveLoadFlag = 2;		// 2 for load
 }
 
+void ScummEngine::requestSnapshot() {
+	_saveLoadSlot = 0;
+	_saveTemporaryState = false;
+	_saveLoadSnapshot = true;
+	_saveLoadFlag = 1;
+	_saveLoadDescription = "Snapshot";
+}
+
+void ScummEngine::requestSnapshotLoad(uint back) {
+	_saveLoadSlot = back;
+	_saveTemporaryState = false;
+	_saveLoadSnapshot = true;
+	_saveLoadFlag = 2;
+}
+
 Common::SeekableReadStream *ScummEngine::openSaveFileForReading(int slot, bool compat, Common::String &fileName) {
 	fileName = makeSavegameName(slot, compat);
 	return _saveFileMan->openForLoading(fileName);
@@ -219,6 +237,113 @@ bool ScummEngine::saveState(int slot, bool compat, Common::String &filename) {
 }
 
 
+SaveSnapshot *ScummEngine::takeSnapshot(const SaveSnapshot *previous, bool thumbnail) {
+	SaveSnapshot *snapshot = new SaveSnapshot(previous, _res->newWriteStamp());
+	SaveGameHeader hdr;
+
+	// Like a regular savegame, with a thumbnail only if it is going to be
+	// written out. Resources which were not written since the previous
+	// snapshot are shared with it instead of being copied.
+	Common::strlcpy(hdr.name, _saveLoadDescription.c_str(), sizeof(hdr.name));
+	saveSaveGameHeader(snapshot, hdr);
+#if !defined(__DS__) && !defined(__N64__) /* && !defined(__PLAYSTATION2__) */
+	if (thumbnail)
+		Graphics::saveThumbnail(*snapshot);
+#endif
+	saveInfos(snapshot);
+
+	Serializer ser(0, snapshot, CURRENT_VER);
+	ser.setSnapshot(snapshot);
+	saveOrLoad(&ser);
+
+	snapshot->finish();
+	snapshot->setCreationTime(_system->getMillis());
+	return snapshot;
+}
+
+bool ScummEngine::saveSnapshot() {
+	SaveSnapshot *snapshot = takeSnapshot(_snapshots.empty() ? 0 : _snapshots.back(), false);
+
+	if (_snapshots.size() >= kMaxSaveSnapshots) {
+		delete _snapshots.front();
+		_snapshots.remove_at(0);
+	}
+	_snapshots.push_back(snapshot);
+
+	debug(1, "Snapshot taken: %d bytes, %d bytes copied, %d of %d resources shared", snapshot->getSize(),
+		snapshot->getCopiedSize(), snapshot->getSharedResources(), snapshot->getNumResources());
+	return true;
+}
+
+bool ScummEngine::loadSnapshot(uint back) {
+	if (back >= _snapshots.size())
+		return false;
+
+	uint index = _snapshots.size() - 1 - back;
+	Common::SeekableReadStream *in = _snapshots[index]->createReadStream();
+	if (!in)
+		return false;
+
+	bool result = loadState(in, false, Common::String::format("snapshot %d", back));
+	delete in;
+
+	// Going back in time discards all newer snapshots
+	if (result) {
+		while (_snapshots.size() > index + 1) {
+			delete _snapshots.back();
+			_snapshots.pop_back();
+		}
+	}
+	return result;
+}
+
+bool ScummEngine::writeSnapshot(uint back, int slot) {
+	Common::String filename;
+
+	if (back >= _snapshots.size())
+		return false;
+
+	return writeSnapshot(_snapshots[_snapshots.size() - 1 - back], slot, filename);
+}
+
+bool ScummEngine::writeSnapshot(const SaveSnapshot *snapshot, int slot, Common::String &filename) {
+	Common::WriteStream *out = openSaveFileForWriting(slot, false, filename);
+	if (!out)
+		return false;
+
+	bool result = snapshot->writeTo(out);
+	out->finalize();
+	if (out->err())
+		result = false;
+	delete out;
+
+	debug(1, "Snapshot %s '%s'", result ? "written to" : "could not be written to", filename.c_str());
+	return result;
+}
+
+bool ScummEngine::saveAutosave(Common::String &filename) {
+	// Autosaves are taken as snapshots of their own, apart from the ones
+	// kept for rewinding, so that only the resources written since the
+	// previous autosave are copied. The save file still has to contain
+	// all of them.
+	pauseEngine(true);
+
+	SaveSnapshot *snapshot = takeSnapshot(_autosaveSnapshot, true);
+	delete _autosaveSnapshot;
+	_autosaveSnapshot = snapshot;
+
+	bool result = writeSnapshot(snapshot, 0, filename);
+
+	pauseEngine(false);
+	return result;
+}
+
+void ScummEngine::clearSnapshots() {
+	for (uint i = 0; i < _snapshots.size(); i++)
+		delete _snapshots[i];
+	_snapshots.clear();
+}
+
 void ScummEngine_v4::prepareSavegame() {
 	Common::MemoryWriteStreamDynamic *memStream;
 	Common::WriteStream *writeStream;
@@ -318,16 +443,21 @@ bool ScummEngine::loadState(int slot, bool compat) {
 }
 
 bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
-	SaveGameHeader hdr;
-	int sb, sh;
-
 	Common::SeekableReadStream *in = openSaveFileForReading(slot, compat, filename);
 	if (!in)
 		return false;
 
+	bool result = loadState(in, compat, filename);
+	delete in;
+	return result;
+}
+
+bool ScummEngine::loadState(Common::SeekableReadStream *in, bool compat, const Common::String &filename) {
+	SaveGameHeader hdr;
+	int sb, sh;
+
 	if (!loadSaveGameHeader(in, hdr)) {
 		warning("Invalid savegame '%s'", filename.c_str());
-		delete in;
 		return false;
 	}
 
@@ -343,14 +473,12 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 	// information).
 	if (hdr.ver < VER(7) || hdr.ver > CURRENT_VER) {
 		warning("Invalid version of '%s'", filename.c_str());
-		delete in;
 		return false;
 	}
 
 	// We (deliberately) broke HE savegame compatibility at some point.
 	if (hdr.ver < VER(50) && _game.heversion >= 71) {
 		warning("Unsupported version of '%s'", filename.c_str());
-		delete in;
 		return false;
 	}
 
@@ -360,7 +488,6 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 		if (hdr.ver <= VER(74)) {
 			if (!Graphics::checkThumbnailHeader(*in)) {
 				warning("Can not load thumbnail");
-				delete in;
 				return false;
 			}
 		}
@@ -374,7 +501,6 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 		SaveStateMetaInfos infos;
 		if (!loadInfos(in, &infos)) {
 			warning("Info section could not be found");
-			delete in;
 			return false;
 		}
 
@@ -444,7 +570,7 @@ bool ScummEngine::loadState(int slot, bool compat, Common::String &filename) {
 	//
 	Serializer ser(in, 0, hdr.ver);
 	saveOrLoad(&ser);
-	delete in;
+	invalidateBoxCache();
 
 	// Update volume settings
 	syncSoundSettings();
@@ -1737,7 +1863,13 @@ void ScummEngine::saveResource(Serializer *ser, ResType type, ResId idx) {
 		uint32 size = _res->_types[type][idx]._size;
 
 		ser->saveUint32(size);
-		ser->saveBytes(ptr, size);
+		if (ser->getSnapshot()) {
+			SaveSnapshot *snapshot = ser->getSnapshot();
+			snapshot->writeResource((type << 16) | idx, ptr, size,
+				_res->isWrittenSince(type, idx, snapshot->getPreviousWriteStamp()));
+		} else {
+			ser->saveBytes(ptr, size);
+		}
 
 		if (type == rtInventory) {
 			ser->saveUint16(_inventory[idx]);
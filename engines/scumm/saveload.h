@@ -120,11 +120,13 @@ struct SaveLoadEntry {
 	uint8 maxVersion;
 };
 
+class SaveSnapshot;
+
 class Serializer {
 public:
 	Serializer(Common::SeekableReadStream *in, Common::WriteStream *out, uint32 savegameVersion)
 		: _loadStream(in), _saveStream(out),
-		  _savegameVersion(savegameVersion)
+		  _savegameVersion(savegameVersion), _snapshot(0)
 	{ }
 
 	void saveLoadArrayOf(void *b, int len, int datasize, byte filetype);
@@ -135,6 +137,13 @@ public:
 	bool isLoading() { return (_loadStream != 0); }
 	uint32 getVersion() { return _savegameVersion; }
 
+	/**
+	 * When saving into a snapshot, resource contents are handed to it
+	 * directly, so they can be shared with the previous snapshot.
+	 */
+	void setSnapshot(SaveSnapshot *snapshot) { _snapshot = snapshot; }
+	SaveSnapshot *getSnapshot() { return _snapshot; }
+
 	void saveUint32(uint32 d);
 	void saveUint16(uint16 d);
 	void saveByte(byte b);
@@ -150,6 +159,7 @@ protected:
 	Common::SeekableReadStream *_loadStream;
 	Common::WriteStream *_saveStream;
 	uint32 _savegameVersion;
+	SaveSnapshot *_snapshot;
 
 	void saveArrayOf(void *b, int len, int datasize, byte filetype);
 	void loadArrayOf(void *b, int len, int datasize, byte filetype);
@@ -27,6 +27,7 @@
 #include "scumm/actor.h"
 #include "scumm/object.h"
 #include "scumm/resource.h"
+#include "scumm/script_profiler.h"
 #include "scumm/util.h"
 #include "scumm/scumm_v0.h"
 #include "scumm/scumm_v2.h"
@@ -335,7 +336,15 @@ void ScummEngine::runScriptNested(int script) {
 	_currentScript = script;
 	getScriptBaseAddress();
 	resetScriptPointer();
-	executeScript();
+
+	if (_scriptProfiler) {
+		slot = &vm.slot[script];
+		_scriptProfiler->enterScript(script, slot->number, slot->where, _currentRoom);
+		executeScript();
+		_scriptProfiler->leaveScript();
+	} else {
+		executeScript();
+	}
 
 	if (vm.numNestedScripts != 0)
 		vm.numNestedScripts--;
@@ -483,6 +492,9 @@ void ScummEngine::executeScript() {
 			debugN("\n");
 		}
 
+		if (_scriptProfiler)
+			_scriptProfiler->countOpcode(_opcode);
+
 		executeOpcode(_opcode);
 
 	}
@@ -900,7 +912,13 @@ void ScummEngine::runAllScripts() {
 				_currentScript = (byte)i;
 				getScriptBaseAddress();
 				resetScriptPointer();
-				executeScript();
+				if (_scriptProfiler) {
+					_scriptProfiler->enterScript(i, vm.slot[i].number, vm.slot[i].where, _currentRoom);
+					executeScript();
+					_scriptProfiler->leaveScript();
+				} else {
+					executeScript();
+				}
 			}
 		}
 	}
@@ -0,0 +1,168 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/algorithm.h"
+#include "common/file.h"
+#include "common/system.h"
+
+#include "scumm/script_profiler.h"
+#include "scumm/scumm.h"
+
+namespace Scumm {
+
+ScriptProfiler::ScriptProfiler(ScummEngine *vm) : _vm(vm) {
+	reset();
+}
+
+void ScriptProfiler::reset() {
+	memset(_opcodeCounts, 0, sizeof(_opcodeCounts));
+	_pendingOpcodes = 0;
+	_stats.clear();
+	_folded.clear();
+
+	// Restart the time accounting of the scripts which are still running
+	uint32 now = g_system->getMillis();
+	for (uint i = 0; i < _frames.size(); i++)
+		_frames[i].startTime = now;
+}
+
+void ScriptProfiler::flush(uint32 now) {
+	if (_frames.empty()) {
+		// Opcodes run outside of any script entered here only show up in
+		// the histogram, don't credit them to the next script
+		_pendingOpcodes = 0;
+		return;
+	}
+
+	Frame &top = _frames.back();
+	ScriptStats &stats = _stats[top.key];
+	stats.opcodes += _pendingOpcodes;
+	stats.millis += now - top.startTime;
+	if (_pendingOpcodes)
+		_folded[top.stack] += _pendingOpcodes;
+
+	top.startTime = now;
+	_pendingOpcodes = 0;
+}
+
+void ScriptProfiler::enterScript(int slot, int number, int where, int room) {
+	uint32 now = g_system->getMillis();
+	flush(now);
+
+	Frame frame;
+	frame.key = ((uint32)(room & 0xFF) << 24) | ((uint32)(where & 0xFF) << 16) | (number & 0xFFFF);
+	frame.startTime = now;
+	if (_frames.empty())
+		frame.stack = Common::String::format("room %d;", room);
+	else
+		frame.stack = _frames.back().stack + ";";
+	frame.stack += Common::String::format("%s %d", getWhereName(where), number);
+	_frames.push_back(frame);
+
+	ScriptStats &stats = _stats[frame.key];
+	if (!stats.runs) {
+		stats.number = number;
+		stats.where = where;
+		stats.room = room;
+	}
+	stats.lastSlot = slot;
+	stats.runs++;
+}
+
+void ScriptProfiler::leaveScript() {
+	flush(g_system->getMillis());
+	if (!_frames.empty())
+		_frames.pop_back();
+}
+
+uint32 ScriptProfiler::getTotalOpcodes() const {
+	uint32 total = 0;
+	for (int i = 0; i < 256; i++)
+		total += _opcodeCounts[i];
+	return total;
+}
+
+static bool compareStats(const ScriptProfiler::ScriptStats &a, const ScriptProfiler::ScriptStats &b) {
+	return a.opcodes > b.opcodes;
+}
+
+Common::Array<ScriptProfiler::ScriptStats> ScriptProfiler::getSortedStats() const {
+	Common::Array<ScriptStats> list;
+	for (StatsMap::const_iterator i = _stats.begin(); i != _stats.end(); ++i)
+		list.push_back(i->_value);
+	Common::sort(list.begin(), list.end(), compareStats);
+	return list;
+}
+
+bool ScriptProfiler::dumpCSV(const Common::String &filename) const {
+	Common::DumpFile out;
+	if (!out.open(filename))
+		return false;
+
+	out.writeString("opcode,name,count\n");
+	for (int i = 0; i < 256; i++) {
+		if (_opcodeCounts[i])
+			out.writeString(Common::String::format("0x%02X,%s,%u\n", i, _vm->getOpcodeDesc(i), _opcodeCounts[i]));
+	}
+
+	out.writeString("\nscript,where,room,slot,runs,opcodes,ms\n");
+	Common::Array<ScriptStats> list = getSortedStats();
+	for (uint i = 0; i < list.size(); i++) {
+		const ScriptStats &s = list[i];
+		out.writeString(Common::String::format("%d,%s,%d,%d,%u,%u,%u\n",
+			s.number, getWhereName(s.where), s.room, s.lastSlot, s.runs, s.opcodes, s.millis));
+	}
+
+	out.finalize();
+	return !out.err();
+}
+
+bool ScriptProfiler::dumpFolded(const Common::String &filename) const {
+	Common::DumpFile out;
+	if (!out.open(filename))
+		return false;
+
+	for (FoldedMap::const_iterator i = _folded.begin(); i != _folded.end(); ++i)
+		out.writeString(Common::String::format("%s %u\n", i->_key.c_str(), i->_value));
+
+	out.finalize();
+	return !out.err();
+}
+
+const char *ScriptProfiler::getWhereName(int where) {
+	switch (where) {
+	case WIO_INVENTORY:
+		return "inventory";
+	case WIO_ROOM:
+		return "room";
+	case WIO_GLOBAL:
+		return "global";
+	case WIO_LOCAL:
+		return "local";
+	case WIO_FLOBJECT:
+		return "flobject";
+	default:
+		return "unknown";
+	}
+}
+
+} // End of namespace Scumm
@@ -0,0 +1,108 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SCUMM_SCRIPT_PROFILER_H
+#define SCUMM_SCRIPT_PROFILER_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+namespace Scumm {
+
+class ScummEngine;
+
+/**
+ * Collects execution statistics of the script VM while enabled via the
+ * 'scriptprof' debugger command: a histogram of all executed opcodes, the
+ * number of opcodes and the time spent in every script (keyed by script
+ * number, where it lives and the current room) and the nesting of scripts,
+ * which can be written out as folded stacks for flame graph tools.
+ *
+ * Time is only available with millisecond resolution, so the executed
+ * opcode count is the more precise measure for short script slices.
+ */
+class ScriptProfiler {
+public:
+	struct ScriptStats {
+		uint16 number;
+		byte where;
+		byte lastSlot;
+		int room;
+		uint32 runs;
+		uint32 opcodes;
+		uint32 millis;
+	};
+
+	ScriptProfiler(ScummEngine *vm);
+
+	void reset();
+
+	/** Called whenever the VM starts executing script slot 'slot'. */
+	void enterScript(int slot, int number, int where, int room);
+	/** Called when the script entered last returns to its caller. */
+	void leaveScript();
+
+	void countOpcode(byte opcode) {
+		_opcodeCounts[opcode]++;
+		_pendingOpcodes++;
+	}
+
+	uint32 getOpcodeCount(byte opcode) const { return _opcodeCounts[opcode]; }
+	uint32 getTotalOpcodes() const;
+
+	/** Returns the per script statistics, sorted by executed opcodes. */
+	Common::Array<ScriptStats> getSortedStats() const;
+
+	/** Write per opcode and per script statistics as CSV. */
+	bool dumpCSV(const Common::String &filename) const;
+	/** Write the script nesting as folded stacks ("a;b;c count"). */
+	bool dumpFolded(const Common::String &filename) const;
+
+	static const char *getWhereName(int where);
+
+private:
+	struct Frame {
+		uint32 key;
+		uint32 startTime;
+		Common::String stack;
+	};
+
+	typedef Common::HashMap<uint32, ScriptStats> StatsMap;
+	typedef Common::HashMap<Common::String, uint32> FoldedMap;
+
+	void flush(uint32 now);
+
+	ScummEngine *_vm;
+
+	uint32 _opcodeCounts[256];
+	uint32 _pendingOpcodes;
+
+	StatsMap _stats;
+	FoldedMap _folded;
+	Common::Array<Frame> _frames;
+};
+
+} // End of namespace Scumm
+
+#endif
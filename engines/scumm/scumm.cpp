@@ -34,6 +34,7 @@
 #include "graphics/cursorman.h"
 
 #include "scumm/akos.h"
+#include "scumm/boxes.h"
 #include "scumm/charset.h"
 #include "scumm/costume.h"
 #include "scumm/debugger.h"
@@ -65,6 +66,8 @@
 #include "scumm/players/player_v4a.h"
 #include "scumm/players/player_v5m.h"
 #include "scumm/resource.h"
+#include "scumm/script_profiler.h"
+#include "scumm/snapshot.h"
 #include "scumm/he/resource_he.h"
 #include "scumm/he/moonbase/moonbase.h"
 #include "scumm/scumm_v0.h"
@@ -115,6 +118,7 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	  _filenamePattern(dr.fp),
 	  _language(dr.language),
 	  _debugger(0),
+	  _scriptProfiler(0),
 	  _currentScript(0xFF), // Let debug() work on init stage
 	  _messageDialog(0), _pauseDialog(0), _versionDialog(0),
 	  _rnd("scumm")
@@ -140,6 +144,7 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 		_gdi = new Gdi(this);
 	}
 	_res = new ResourceManager(this);
+	_boxCache = new BoxCache();
 
 	// Convert MD5 checksum back into a digest
 	for (int i = 0; i < 16; ++i) {
@@ -216,6 +221,8 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	_saveLoadFlag = 0;
 	_saveLoadSlot = 0;
 	_lastSaveTime = 0;
+	_saveLoadSnapshot = false;
+	_autosaveSnapshot = 0;
 	_saveTemporaryState = false;
 	memset(_localScriptOffsets, 0, sizeof(_localScriptOffsets));
 	_scriptPointer = NULL;
@@ -646,7 +653,11 @@ ScummEngine::~ScummEngine() {
 #endif
 
 	delete _debugger;
+	delete _scriptProfiler;
+	clearSnapshots();
+	delete _autosaveSnapshot;
 
+	delete _boxCache;
 	delete _res;
 	delete _gdi;
 }
@@ -2422,7 +2433,20 @@ void ScummEngine::scummLoop_handleSaveLoad() {
 			VAR(VAR_GAME_LOADED) = 0;
 
 		Common::String filename;
-		if (_saveLoadFlag == 1) {
+		if (_saveLoadSnapshot) {
+			// Snapshots live in memory only and are taken silently
+			if (_saveLoadFlag == 1) {
+				success = saveSnapshot();
+			} else {
+				success = loadSnapshot(_saveLoadSlot);
+				if (!success)
+					warning("Failed to restore snapshot %d", _saveLoadSlot);
+			}
+		} else if (_saveLoadFlag == 1 && _saveLoadSlot == 0 && !_saveTemporaryState) {
+			success = saveAutosave(filename);
+			if (!success)
+				errMsg = _("Failed to save game state to file:\n\n%s");
+		} else if (_saveLoadFlag == 1) {
 			success = saveState(_saveLoadSlot, _saveTemporaryState, filename);
 			if (!success)
 				errMsg = _("Failed to save game state to file:\n\n%s");
@@ -2438,7 +2462,9 @@ void ScummEngine::scummLoop_handleSaveLoad() {
 				VAR(VAR_GAME_LOADED) = (_game.version == 8) ? 1 : 203;
 		}
 
-		if (!success) {
+		if (_saveLoadSnapshot) {
+			// Nothing to report
+		} else if (!success) {
 			displayMessage(0, errMsg, filename.c_str());
 		} else if (_saveLoadFlag == 1 && _saveLoadSlot != 0 && !_saveTemporaryState) {
 			// Display "Save successful" message, except for auto saves
@@ -2452,6 +2478,7 @@ void ScummEngine::scummLoop_handleSaveLoad() {
 			clearClickedStatus();
 
 		_saveLoadFlag = 0;
+		_saveLoadSnapshot = false;
 		_lastSaveTime = _system->getMillis();
 	}
 }
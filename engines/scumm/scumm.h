@@ -88,10 +88,13 @@ class MusicEngine;
 class Player_Towns;
 class ScummEngine;
 class ScummDebugger;
+class SaveSnapshot;
+class ScriptProfiler;
 class Serializer;
 class Sound;
 
 struct Box;
+class BoxCache;
 struct BoxCoords;
 struct FindObjectInRoom;
 
@@ -376,6 +379,7 @@ class ResourceManager;
  */
 class ScummEngine : public Engine {
 	friend class ScummDebugger;
+	friend class ScriptProfiler;
 	friend class CharsetRenderer;
 	friend class CharsetRendererTownsClassic;
 	friend class ResourceManager;
@@ -393,6 +397,7 @@ public:
 	VerbSlot *_verbs;
 	ObjectData *_objs;
 	ScummDebugger *_debugger;
+	ScriptProfiler *_scriptProfiler;
 
 	// Core variables
 	GameSettings _game;
@@ -603,10 +608,24 @@ protected:
 	Common::String _saveLoadFileName;
 	Common::String _saveLoadDescription;
 
+	// In-memory delta snapshots, oldest first, and the last autosave
+	bool _saveLoadSnapshot;
+	Common::Array<SaveSnapshot *> _snapshots;
+	SaveSnapshot *_autosaveSnapshot;
+
+	SaveSnapshot *takeSnapshot(const SaveSnapshot *previous, bool thumbnail);
+	bool saveSnapshot();
+	bool loadSnapshot(uint back);
+	bool writeSnapshot(uint back, int slot);
+	bool writeSnapshot(const SaveSnapshot *snapshot, int slot, Common::String &filename);
+	bool saveAutosave(Common::String &filename);
+	void clearSnapshots();
+
 	bool saveState(Common::WriteStream *out, bool writeHeader = true);
 	bool saveState(int slot, bool compat, Common::String &fileName);
 	bool loadState(int slot, bool compat);
 	bool loadState(int slot, bool compat, Common::String &fileName);
+	bool loadState(Common::SeekableReadStream *in, bool compat, const Common::String &fileName);
 	virtual void saveOrLoad(Serializer *s);
 	void saveResource(Serializer *ser, ResType type, ResId idx);
 	void loadResource(Serializer *ser, ResType type, ResId idx);
@@ -629,6 +648,8 @@ public:
 
 	void requestSave(int slot, const Common::String &name);
 	void requestLoad(int slot);
+	void requestSnapshot();
+	void requestSnapshotLoad(uint back);
 
 	Common::String getTargetName() const { return _targetName; }
 
@@ -757,9 +778,12 @@ protected:
 	int getResourceRoomNr(ResType type, ResId idx);
 	virtual uint32 getResourceRoomOffset(ResType type, ResId idx);
 	int getResourceSize(ResType type, ResId idx);
+	byte *lookupResourceAddress(ResType type, ResId idx, bool forWriting);
 
 public:
 	byte *getResourceAddress(ResType type, ResId idx);
+	/** Like getResourceAddress(), for callers which do not modify the data. */
+	const byte *getResourceAddressForReading(ResType type, ResId idx);
 	virtual byte *getStringAddress(ResId idx);
 	byte *getStringAddressVar(int i);
 	void ensureResourceLoaded(ResType type, ResId idx);
@@ -1151,6 +1175,9 @@ public:
 
 	BoxCoords getBoxCoordinates(int boxnum);
 
+	const BoxCache *getBoxCache();
+	void invalidateBoxCache();
+
 	byte getMaskFromBox(int box);
 	Box *getBoxBaseAddr(int box);
 	byte getBoxFlags(int box);
@@ -1174,6 +1201,10 @@ protected:
 	void createBoxMatrix();
 	virtual bool areBoxesNeighbors(int i, int j);
 
+	BoxCache *_boxCache;
+	BoxCoords decodeBoxCoordinates(int boxnum);
+	void rebuildBoxCache(const byte *boxes, const byte *matrix);
+
 	/* String class */
 public:
 	CharsetRenderer *_charset;
@@ -117,7 +117,7 @@ bool SmushMixer::handleFrame() {
 				if (_mixer->isReady()) {
 					// Stream the data
 					if (!_channels[i].stream) {
-						_channels[i].stream = Audio::makeQueuingAudioStream(_channels[i].chan->getRate(), stereo);
+						_channels[i].stream = Audio::makeLockFreeQueuingAudioStream(_channels[i].chan->getRate(), stereo);
 						_mixer->playStream(Audio::Mixer::kSFXSoundType, &_channels[i].handle, _channels[i].stream);
 					}
 					_mixer->setChannelVolume(_channels[i].handle, vol);
@@ -0,0 +1,131 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/memstream.h"
+#include "common/textconsole.h"
+
+#include "scumm/snapshot.h"
+
+namespace Scumm {
+
+SaveSnapshot::SaveSnapshot(const SaveSnapshot *previous, uint32 writeStamp)
+	: _previous(previous), _pending(0), _pendingSize(0), _pendingCapacity(0),
+	  _size(0), _copiedSize(0), _sharedResources(0), _creationTime(0),
+	  _writeStamp(writeStamp), _previousWriteStamp(previous ? previous->_writeStamp : 0) {
+}
+
+SaveSnapshot::~SaveSnapshot() {
+	free(_pending);
+}
+
+uint32 SaveSnapshot::write(const void *dataPtr, uint32 dataSize) {
+	if (_pendingSize + dataSize > _pendingCapacity) {
+		uint32 capacity = MAX<uint32>(_pendingCapacity * 2, 4096);
+		while (capacity < _pendingSize + dataSize)
+			capacity *= 2;
+
+		byte *pending = (byte *)realloc(_pending, capacity);
+		if (!pending)
+			error("SaveSnapshot: Out of memory");
+		_pending = pending;
+		_pendingCapacity = capacity;
+	}
+
+	memcpy(_pending + _pendingSize, dataPtr, dataSize);
+	_pendingSize += dataSize;
+	_size += dataSize;
+	_copiedSize += dataSize;
+	return dataSize;
+}
+
+void SaveSnapshot::flushPending() {
+	if (!_pendingSize)
+		return;
+
+	// Hand the buffer over to the chunk, trimmed to the used size
+	byte *data = (byte *)realloc(_pending, _pendingSize);
+	_chunks.push_back(BlobPtr(new Blob(data ? data : _pending, _pendingSize)));
+
+	_pending = 0;
+	_pendingSize = 0;
+	_pendingCapacity = 0;
+}
+
+void SaveSnapshot::writeResource(uint32 key, const byte *ptr, uint32 size, bool written) {
+	BlobPtr blob;
+
+	flushPending();
+
+	if (_previous && !written) {
+		ResourceMap::const_iterator i = _previous->_resources.find(key);
+		if (i != _previous->_resources.end() && i->_value->size == size) {
+			blob = i->_value;
+			_sharedResources++;
+		}
+	}
+
+	if (!blob) {
+		byte *data = (byte *)malloc(size);
+		if (!data)
+			error("SaveSnapshot: Out of memory");
+		memcpy(data, ptr, size);
+		blob = BlobPtr(new Blob(data, size));
+		_copiedSize += size;
+	}
+
+	_resources[key] = blob;
+	_chunks.push_back(blob);
+	_size += size;
+}
+
+void SaveSnapshot::finish() {
+	flushPending();
+	_previous = 0;
+}
+
+bool SaveSnapshot::writeTo(Common::WriteStream *out) const {
+	assert(!_pendingSize);
+
+	for (uint i = 0; i < _chunks.size(); i++) {
+		if (out->write(_chunks[i]->data, _chunks[i]->size) != _chunks[i]->size)
+			return false;
+	}
+	return !out->err();
+}
+
+Common::SeekableReadStream *SaveSnapshot::createReadStream() const {
+	assert(!_pendingSize);
+
+	byte *data = (byte *)malloc(_size);
+	if (!data)
+		return 0;
+
+	byte *dst = data;
+	for (uint i = 0; i < _chunks.size(); i++) {
+		memcpy(dst, _chunks[i]->data, _chunks[i]->size);
+		dst += _chunks[i]->size;
+	}
+
+	return new Common::MemoryReadStream(data, _size, DisposeAfterUse::YES);
+}
+
+} // End of namespace Scumm
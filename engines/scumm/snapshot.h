@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef SCUMM_SNAPSHOT_H
+#define SCUMM_SNAPSHOT_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/ptr.h"
+#include "common/stream.h"
+
+namespace Scumm {
+
+enum {
+	/** The number of snapshots kept by ScummEngine before the oldest is dropped. */
+	kMaxSaveSnapshots = 16
+};
+
+/**
+ * An in-memory savegame, as produced by ScummEngine::saveSnapshot().
+ *
+ * The serializer writes into the snapshot like into any other stream, except
+ * for the contents of resources (scripts, arrays, inventory, ...), which are
+ * passed in through writeResource(). Resources which were not written since
+ * the previous snapshot was taken, as tracked by the resource manager, are
+ * shared with it, so only the modified resources are copied. With HE games,
+ * where most of the savegame consists of large and mostly static arrays,
+ * this keeps frequent snapshots cheap in both time and memory.
+ *
+ * Flattening a snapshot yields exactly the data a regular savegame file
+ * contains, so it can be loaded through the normal loadState() code and
+ * written out as an ordinary savegame.
+ */
+class SaveSnapshot : public Common::WriteStream {
+public:
+	/**
+	 * Create an empty snapshot. If previous is given, it must stay alive
+	 * until finish() has been called. writeStamp is the write stamp of the
+	 * resource manager at the time the snapshot is taken.
+	 */
+	SaveSnapshot(const SaveSnapshot *previous, uint32 writeStamp);
+	virtual ~SaveSnapshot();
+
+	virtual uint32 write(const void *dataPtr, uint32 dataSize);
+	virtual int32 pos() const { return _size; }
+
+	/**
+	 * Append the contents of the resource identified by key. Unless written
+	 * is set, the resource has not changed since the previous snapshot and
+	 * its data is shared with it.
+	 */
+	void writeResource(uint32 key, const byte *ptr, uint32 size, bool written);
+
+	/** Write stamp of the previous snapshot, if there is one. */
+	uint32 getPreviousWriteStamp() const { return _previousWriteStamp; }
+
+	/** Complete the snapshot. No more data may be written afterwards. */
+	void finish();
+
+	/** Total size of the flattened savegame data. */
+	uint32 getSize() const { return _size; }
+	/** Number of bytes copied for this snapshot, i.e. the delta. */
+	uint32 getCopiedSize() const { return _copiedSize; }
+	/** Number of resources which were shared with the previous snapshot. */
+	uint32 getSharedResources() const { return _sharedResources; }
+	uint32 getNumResources() const { return _resources.size(); }
+
+	uint32 getCreationTime() const { return _creationTime; }
+	void setCreationTime(uint32 time) { _creationTime = time; }
+
+	/** Write the flattened savegame data to out. */
+	bool writeTo(Common::WriteStream *out) const;
+	/** Return a stream over the flattened savegame data. */
+	Common::SeekableReadStream *createReadStream() const;
+
+private:
+	struct Blob {
+		byte *data;
+		uint32 size;
+
+		Blob(byte *d, uint32 s) : data(d), size(s) {}
+		~Blob() { free(data); }
+	};
+
+	typedef Common::SharedPtr<Blob> BlobPtr;
+	typedef Common::HashMap<uint32, BlobPtr> ResourceMap;
+
+	void flushPending();
+
+	const SaveSnapshot *_previous;
+	Common::Array<BlobPtr> _chunks;
+	ResourceMap _resources;
+
+	byte *_pending;
+	uint32 _pendingSize;
+	uint32 _pendingCapacity;
+
+	uint32 _size;
+	uint32 _copiedSize;
+	uint32 _sharedResources;
+	uint32 _creationTime;
+	uint32 _writeStamp;
+	uint32 _previousWriteStamp;
+};
+
+} // End of namespace Scumm
+
+#endif
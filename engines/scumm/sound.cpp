@@ -37,6 +37,7 @@
 #include "scumm/sound.h"
 
 #include "audio/audiostream.h"
+#include "audio/decodedcache.h"
 #include "audio/timestamp.h"
 #include "audio/decoders/flac.h"
 #include "audio/mididrv.h"
@@ -623,35 +624,55 @@ void Sound::startTalkSound(uint32 offset, uint32 b, int mode, Audio::SoundHandle
 
 	if (!_soundsPaused && _mixer->isReady()) {
 		Audio::AudioStream *input = NULL;
+		Audio::SeekableAudioStream *compressed = NULL;
+
+		// Sound effects are often played again, so their decoded data
+		// is kept around instead of decoding them every time
+		Common::String cacheKey;
+		if (mode == 1 && _soundMode != kVOCMode) {
+			cacheKey = Audio::DecodedAudioCache::makeKey(Common::String::format("%s:%u", _sfxFilename.c_str(), offset),
+			                                             _soundMode == kMP3Mode ? "mp3" : (_soundMode == kVorbisMode ? "vorbis" : "flac"));
+			bool rejected;
+			input = DecodedAudioCacheMan.find(cacheKey, &rejected);
+
+			// Too large to be cached, do not try again
+			if (rejected)
+				cacheKey.clear();
+		}
 
-		switch (_soundMode) {
-		case kMP3Mode:
+		if (!input) {
+			switch (_soundMode) {
+			case kMP3Mode:
 #ifdef USE_MAD
-			{
-			assert(size > 0);
-			input = Audio::makeMP3Stream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+				{
+				assert(size > 0);
+				compressed = Audio::makeMP3Stream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+				}
 #endif
-			break;
-		case kVorbisMode:
+				break;
+			case kVorbisMode:
 #ifdef USE_VORBIS
-			{
-			assert(size > 0);
-			input = Audio::makeVorbisStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+				{
+				assert(size > 0);
+				compressed = Audio::makeVorbisStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+				}
 #endif
-			break;
-		case kFLACMode:
+				break;
+			case kFLACMode:
 #ifdef USE_FLAC
-			{
-			assert(size > 0);
-			input = Audio::makeFLACStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
-			}
+				{
+				assert(size > 0);
+				compressed = Audio::makeFLACStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+				}
 #endif
-			break;
-		default:
-			input = Audio::makeVOCStream(file.release(), Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
-			break;
+				break;
+			default:
+				input = Audio::makeVOCStream(file.release(), Audio::FLAG_UNSIGNED, DisposeAfterUse::YES);
+				break;
+			}
+
+			if (compressed)
+				input = cacheKey.empty() ? compressed : DecodedAudioCacheMan.insert(cacheKey, compressed);
 		}
 
 		if (!input) {
@@ -90,6 +90,9 @@ void AdScene::setDefaults() {
 	_mainLayer = nullptr;
 
 	_pfPointsNum = 0;
+	_pfOpenListValid = false;
+	_pfRegionsSignature = 0;
+	_pfRegionsSignatureValid = false;
 	_persistentState = false;
 	_persistentStateSprites = true;
 
@@ -175,6 +178,10 @@ void AdScene::cleanup() {
 	}
 	_pfPath.clear();
 	_pfPointsNum = 0;
+	_pfOpenList.clear();
+	_pfWalkCache.clear();
+	_pfLineCache.clear();
+	_pfBlockers.clear();
 
 	for (uint32 i = 0; i < _objects.size(); i++) {
 		_gameRef->unregisterObject(_objects[i]);
@@ -468,18 +475,303 @@ int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Scenes larger than this (in pixels) don't get a walkability bitmap
+static const uint32 kPathFinderMaxWalkCachePixels = 16 * 1024 * 1024;
+// Line visibility results kept between searches before the cache is flushed
+static const uint32 kPathFinderMaxLineCacheEntries = 64 * 1024;
+
+static inline bool pfNodeLess(int32 distance1, int32 index1, int32 distance2, int32 index2) {
+	// ties go to the lower index, same as the linear scan this replaced
+	return distance1 < distance2 || (distance1 == distance2 && index1 < index2);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfOpenListPush(int32 distance, int32 index) {
+	PathFinderNode node;
+	node._distance = distance;
+	node._index = index;
+
+	uint32 pos = _pfOpenList.size();
+	_pfOpenList.push_back(node);
+	while (pos > 0) {
+		uint32 parent = (pos - 1) / 2;
+		if (!pfNodeLess(node._distance, node._index, _pfOpenList[parent]._distance, _pfOpenList[parent]._index)) {
+			break;
+		}
+		_pfOpenList[pos] = _pfOpenList[parent];
+		pos = parent;
+	}
+	_pfOpenList[pos] = node;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::pfOpenListPop(PathFinderNode &node) {
+	if (_pfOpenList.empty()) {
+		return false;
+	}
+
+	node = _pfOpenList[0];
+	PathFinderNode last = _pfOpenList.back();
+	_pfOpenList.pop_back();
+
+	uint32 size = _pfOpenList.size();
+	if (size == 0) {
+		return true;
+	}
+
+	uint32 pos = 0;
+	for (;;) {
+		uint32 child = pos * 2 + 1;
+		if (child >= size) {
+			break;
+		}
+		if (child + 1 < size && pfNodeLess(_pfOpenList[child + 1]._distance, _pfOpenList[child + 1]._index, _pfOpenList[child]._distance, _pfOpenList[child]._index)) {
+			child++;
+		}
+		if (!pfNodeLess(_pfOpenList[child]._distance, _pfOpenList[child]._index, last._distance, last._index)) {
+			break;
+		}
+		_pfOpenList[pos] = _pfOpenList[child];
+		pos = child;
+	}
+	_pfOpenList[pos] = last;
+	return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfOpenListRebuild() {
+	_pfOpenList.clear();
+	for (int32 i = 0; i < _pfPointsNum; i++) {
+		if (!_pfPath[i]->_marked && _pfPath[i]->_distance < INT_MAX) {
+			pfOpenListPush(_pfPath[i]->_distance, i);
+		}
+	}
+	_pfOpenListValid = true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfUpdateRegionsSignature() {
+	uint32 hash = 2166136261u;
+#define PF_HASH(val) hash = (hash ^ (uint32)(val)) * 16777619u
+
+	PF_HASH((size_t)_mainLayer);
+	PF_HASH(_width);
+	PF_HASH(_height);
+	if (_mainLayer) {
+		for (uint32 i = 0; i < _mainLayer->_nodes.size(); i++) {
+			AdSceneNode *node = _mainLayer->_nodes[i];
+			if (node->_type != OBJECT_REGION) {
+				continue;
+			}
+			AdRegion *region = node->_region;
+			PF_HASH((size_t)region);
+			PF_HASH(region->_active | (region->isBlocked() << 1) | (region->hasDecoration() << 2));
+			PF_HASH(region->_rect.left);
+			PF_HASH(region->_rect.top);
+			PF_HASH(region->_rect.right);
+			PF_HASH(region->_rect.bottom);
+			PF_HASH(region->_points.size());
+			for (uint32 j = 0; j < region->_points.size(); j++) {
+				PF_HASH(region->_points[j]->x);
+				PF_HASH(region->_points[j]->y);
+			}
+		}
+	}
+#undef PF_HASH
+
+	if (_pfRegionsSignatureValid && hash == _pfRegionsSignature) {
+		return;
+	}
+
+	_pfRegionsSignature = hash;
+	_pfRegionsSignatureValid = true;
+
+	_pfLineCache.clear();
+	_pfWalkCache.clear();
+	if (_width > 0 && _height > 0 && (uint32)_width * (uint32)_height <= kPathFinderMaxWalkCachePixels) {
+		_pfWalkCache.resize(((uint32)_width * (uint32)_height + 3) / 4);
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfCollectBlockers(BaseObject *requester) {
+	_pfBlockers.clear();
+
+	for (uint32 i = 0; i < _objects.size(); i++) {
+		if (_objects[i]->_active && _objects[i] != requester && _objects[i]->_currentBlockRegion) {
+			_pfBlockers.push_back(_objects[i]->_currentBlockRegion);
+		}
+	}
+	AdGame *adGame = (AdGame *)_gameRef;
+	for (uint32 i = 0; i < adGame->_objects.size(); i++) {
+		if (adGame->_objects[i]->_active && adGame->_objects[i] != requester && adGame->_objects[i]->_currentBlockRegion) {
+			_pfBlockers.push_back(adGame->_objects[i]->_currentBlockRegion);
+		}
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::pfIsBlockedStatic(int x, int y) {
+	if (_pfWalkCache.empty() || x < 0 || y < 0 || x >= _width || y >= _height) {
+		return isBlockedAt(x, y, false, nullptr);
+	}
+
+	// two bits per pixel: 0 = not evaluated yet, 1 = walkable, 2 = blocked
+	uint32 pixel = (uint32)y * (uint32)_width + (uint32)x;
+	byte &cell = _pfWalkCache[pixel >> 2];
+	int shift = (pixel & 3) * 2;
+	byte state = (cell >> shift) & 3;
+	if (state == 0) {
+		state = isBlockedAt(x, y, false, nullptr) ? 2 : 1;
+		cell |= state << shift;
+	}
+	return state == 2;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::pfIsBlockedByObjects(int x, int y) {
+	for (uint32 i = 0; i < _pfBlockers.size(); i++) {
+		if (_pfBlockers[i]->pointInRegion(x, y)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Same walk as getPointsDist(), checking either the scene regions or the
+// free object blockers only. Both directions visit the same pixels.
+bool AdScene::pfIsLineBlocked(const BasePoint &p1, const BasePoint &p2, bool objectsOnly) {
+	double xStep, yStep, x, y;
+	int xLength, yLength, xCount, yCount;
+	int x1, y1, x2, y2;
+
+	x1 = p1.x;
+	y1 = p1.y;
+	x2 = p2.x;
+	y2 = p2.y;
+
+	xLength = abs(x2 - x1);
+	yLength = abs(y2 - y1);
+
+	if (xLength > yLength) {
+		if (x1 > x2) {
+			BaseUtils::swap(&x1, &x2);
+			BaseUtils::swap(&y1, &y2);
+		}
+
+		yStep = (double)(y2 - y1) / (double)(x2 - x1);
+		y = y1;
+
+		for (xCount = x1; xCount < x2; xCount++) {
+			if (objectsOnly ? pfIsBlockedByObjects(xCount, (int)y) : pfIsBlockedStatic(xCount, (int)y)) {
+				return true;
+			}
+			y += yStep;
+		}
+	} else {
+		if (y1 > y2) {
+			BaseUtils::swap(&x1, &x2);
+			BaseUtils::swap(&y1, &y2);
+		}
+
+		xStep = (double)(x2 - x1) / (double)(y2 - y1);
+		x = x1;
+
+		for (yCount = y1; yCount < y2; yCount++) {
+			if (objectsOnly ? pfIsBlockedByObjects((int)x, yCount) : pfIsBlockedStatic((int)x, yCount)) {
+				return true;
+			}
+			x += xStep;
+		}
+	}
+	return false;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Equivalent to getPointsDist() with the current _pfRequester, using the
+// pathfinder caches. pfUpdateRegionsSignature() and pfCollectBlockers()
+// must have been called for the current step.
+int AdScene::pfGetPointsDist(const BasePoint &p1, const BasePoint &p2) {
+	int minX = MIN(p1.x, p2.x);
+	int maxX = MAX(p1.x, p2.x);
+	int minY = MIN(p1.y, p2.y);
+	int maxY = MAX(p1.y, p2.y);
+
+	// scene regions only change on script action, so remember the result
+	// for each segment until they do
+	bool blocked;
+	if (minX >= -32768 && maxX <= 32767 && minY >= -32768 && maxY <= 32767) {
+		const BasePoint *a = &p1;
+		const BasePoint *b = &p2;
+		if (a->x > b->x || (a->x == b->x && a->y > b->y)) {
+			SWAP(a, b);
+		}
+		uint64 key = ((uint64)(uint16)a->x << 48) | ((uint64)(uint16)a->y << 32) | ((uint64)(uint16)b->x << 16) | (uint64)(uint16)b->y;
+
+		PathFinderLineCache::const_iterator it = _pfLineCache.find(key);
+		if (it != _pfLineCache.end()) {
+			blocked = it->_value;
+		} else {
+			blocked = pfIsLineBlocked(*a, *b, false);
+			if (_pfLineCache.size() >= kPathFinderMaxLineCacheEntries) {
+				_pfLineCache.clear();
+			}
+			_pfLineCache[key] = blocked;
+		}
+	} else {
+		blocked = pfIsLineBlocked(p1, p2, false);
+	}
+	if (blocked) {
+		return -1;
+	}
+
+	// free objects move, so they are checked every time, but only when one
+	// of them can actually touch the segment
+	for (uint32 i = 0; i < _pfBlockers.size(); i++) {
+		const Rect32 &rect = _pfBlockers[i]->_rect;
+		if (rect.left <= maxX && rect.right > minX && rect.top <= maxY && rect.bottom > minY) {
+			if (pfIsLineBlocked(p1, p2, true)) {
+				return -1;
+			}
+			break;
+		}
+	}
+
+	return MAX(maxX - minX, maxY - minY);
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 void AdScene::pathFinderStep() {
-	int i;
+	if (!_pfOpenListValid) {
+		pfOpenListRebuild();
+	}
+	pfUpdateRegionsSignature();
+	pfCollectBlockers(_pfRequester);
+
 	// get lowest unmarked
-	int lowestDist = INT_MAX;
 	AdPathPoint *lowestPt = nullptr;
-
-	for (i = 0; i < _pfPointsNum; i++)
-		if (!_pfPath[i]->_marked && _pfPath[i]->_distance < lowestDist) {
-			lowestDist = _pfPath[i]->_distance;
-			lowestPt = _pfPath[i];
+	PathFinderNode node;
+	while (pfOpenListPop(node)) {
+		AdPathPoint *pt = _pfPath[node._index];
+		// entries are not removed when a point gets a shorter distance,
+		// skip the outdated ones
+		if (!pt->_marked && pt->_distance == node._distance) {
+			lowestPt = pt;
+			break;
 		}
+	}
 
 	if (lowestPt == nullptr) { // no path -> terminate PathFinder
 		_pfReady = true;
@@ -502,14 +794,26 @@ void AdScene::pathFinderStep() {
 	}
 
 	// otherwise keep on searching
-	for (i = 0; i < _pfPointsNum; i++)
-		if (!_pfPath[i]->_marked) {
-			int j = getPointsDist(*lowestPt, *_pfPath[i], _pfRequester);
-			if (j != -1 && lowestPt->_distance + j < _pfPath[i]->_distance) {
-				_pfPath[i]->_distance = lowestPt->_distance + j;
-				_pfPath[i]->_origin = lowestPt;
-			}
+	for (int32 i = 0; i < _pfPointsNum; i++) {
+		AdPathPoint *pt = _pfPath[i];
+		if (pt->_marked) {
+			continue;
+		}
+
+		// the segment can't be shorter than this, so don't bother walking
+		// it if that already can't improve the point
+		int minDist = MAX(abs(pt->x - lowestPt->x), abs(pt->y - lowestPt->y));
+		if (lowestPt->_distance + minDist >= pt->_distance) {
+			continue;
 		}
+
+		int j = pfGetPointsDist(*lowestPt, *pt);
+		if (j != -1 && lowestPt->_distance + j < pt->_distance) {
+			pt->_distance = lowestPt->_distance + j;
+			pt->_origin = lowestPt;
+			pfOpenListPush(pt->_distance, i);
+		}
+	}
 }
 
 
@@ -2348,6 +2652,12 @@ bool AdScene::persist(BasePersistenceManager *persistMgr) {
 	persistMgr->transferPtr(TMEMBER_PTR(_pfRequester));
 	persistMgr->transferPtr(TMEMBER_PTR(_pfTarget));
 	persistMgr->transferPtr(TMEMBER_PTR(_pfTargetPath));
+	if (!persistMgr->getIsSaving()) {
+		// the pathfinder caches are rebuilt from the restored state
+		_pfOpenListValid = false;
+		_pfRegionsSignature = 0;
+		_pfRegionsSignatureValid = false;
+	}
 	_rotLevels.persist(persistMgr);
 	_scaleLevels.persist(persistMgr);
 	persistMgr->transferSint32(TMEMBER(_scrollPixelsH));
@@ -2511,6 +2821,7 @@ bool AdScene::correctTargetPoint(int32 startX, int32 startY, int32 *argX, int32
 //////////////////////////////////////////////////////////////////////////
 void AdScene::pfPointsStart() {
 	_pfPointsNum = 0;
+	_pfOpenListValid = false;
 }
 
 
@@ -30,6 +30,8 @@
 #define WINTERMUTE_ADSCENE_H
 
 #include "engines/wintermute/base/base_fader.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 
 namespace Wintermute {
 
@@ -44,6 +46,7 @@ class AdPath;
 class AdScaleLevel;
 class AdRotLevel;
 class AdPathPoint;
+class BaseRegion;
 class AdScene : public BaseObject {
 public:
 
@@ -171,6 +174,37 @@ private:
 	BaseObject *_pfRequester;
 	BaseArray<AdPathPoint *> _pfPath;
 
+	// Pathfinder working state. None of this is persisted; it is derived
+	// from _pfPath and the scene regions and rebuilt on demand.
+	struct PathFinderNode {
+		int32 _distance;
+		int32 _index;
+	};
+	struct PathFinderLineHash {
+		uint operator()(uint64 key) const {
+			return (uint)(key ^ (key >> 29) ^ (key >> 47));
+		}
+	};
+	typedef Common::HashMap<uint64, bool, PathFinderLineHash> PathFinderLineCache;
+
+	Common::Array<PathFinderNode> _pfOpenList;
+	bool _pfOpenListValid;
+	Common::Array<byte> _pfWalkCache;
+	PathFinderLineCache _pfLineCache;
+	uint32 _pfRegionsSignature;
+	bool _pfRegionsSignatureValid;
+	Common::Array<BaseRegion *> _pfBlockers;
+
+	void pfOpenListPush(int32 distance, int32 index);
+	bool pfOpenListPop(PathFinderNode &node);
+	void pfOpenListRebuild();
+	void pfUpdateRegionsSignature();
+	void pfCollectBlockers(BaseObject *requester);
+	bool pfIsBlockedStatic(int x, int y);
+	bool pfIsBlockedByObjects(int x, int y);
+	bool pfIsLineBlocked(const BasePoint &p1, const BasePoint &p2, bool objectsOnly);
+	int pfGetPointsDist(const BasePoint &p1, const BasePoint &p2);
+
 	int32 _offsetTop;
 	int32 _offsetLeft;
 
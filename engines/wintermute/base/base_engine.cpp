@@ -29,6 +29,7 @@
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_engine.h"
+#include "engines/wintermute/base/scriptables/script_symbol_table.h"
 #include "engines/wintermute/wintermute.h"
 #include "engines/wintermute/system/sys_class_registry.h"
 #include "common/system.h"
@@ -42,6 +43,7 @@ BaseEngine::BaseEngine() {
 	_fileManager = nullptr;
 	_gameRef = nullptr;
 	_classReg = nullptr;
+	_symbolTable = new ScSymbolTable();
 	_rnd = nullptr;
 	_gameId = "";
 	_language = Common::UNK_LANG;
@@ -59,6 +61,7 @@ BaseEngine::~BaseEngine() {
 	delete _fileManager;
 	delete _rnd;
 	delete _classReg;
+	delete _symbolTable;
 }
 
 void BaseEngine::createInstance(const Common::String &targetName, const Common::String &gameId, Common::Language lang, WMETargetExecutable targetExecutable) {
@@ -44,6 +44,7 @@ class BaseGame;
 class BaseSoundMgr;
 class BaseRenderer;
 class SystemClassRegistry;
+class ScSymbolTable;
 class Timer;
 class BaseEngine : public Common::Singleton<Wintermute::BaseEngine> {
 	void init();
@@ -54,6 +55,7 @@ class BaseEngine : public Common::Singleton<Wintermute::BaseEngine> {
 	// We need random numbers
 	Common::RandomSource *_rnd;
 	SystemClassRegistry *_classReg;
+	ScSymbolTable *_symbolTable;
 	Common::Language _language;
 	WMETargetExecutable _targetExecutable;
 public:
@@ -67,6 +69,7 @@ public:
 	uint32 randInt(int from, int to);
 
 	SystemClassRegistry *getClassRegistry() { return _classReg; }
+	ScSymbolTable *getSymbolTable() { return _symbolTable; }
 	BaseGame *getGameRef() { return _gameRef; }
 	BaseFileManager *getFileManager() { return _fileManager; }
 	BaseSoundMgr *getSoundMgr();
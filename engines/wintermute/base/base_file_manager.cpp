@@ -31,6 +31,7 @@
 #include "engines/wintermute/base/file/base_disk_file.h"
 #include "engines/wintermute/base/file/base_save_thumb_file.h"
 #include "engines/wintermute/base/file/base_package.h"
+#include "engines/wintermute/base/file/base_file_entry.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/wintermute.h"
 #include "common/debug.h"
@@ -44,10 +45,17 @@
 #include "common/file.h"
 #include "common/savefile.h"
 #include "common/fs.h"
+#include "common/memstream.h"
 #include "common/unzip.h"
 
 namespace Wintermute {
 
+// Compressed package members are kept decompressed in an LRU cache, so that
+// files used by every scene (scripts, fonts, interface sprites) are only
+// inflated once.
+#define PKG_CACHE_BUDGET (8 * 1024 * 1024)
+#define PKG_CACHE_MAX_FILE_SIZE (1024 * 1024)
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -56,6 +64,7 @@ namespace Wintermute {
 BaseFileManager::BaseFileManager(Common::Language lang, bool detectionMode) {
 	_detectionMode = detectionMode;
 	_language = lang;
+	_pkgCacheSize = 0;
 	_resources = nullptr;
 	initResources();
 	initPaths();
@@ -80,6 +89,7 @@ bool BaseFileManager::cleanup() {
 	_openFiles.clear();
 
 	// delete packages
+	clearPkgCache();
 	_packages.clear();
 
 	// get rid of the resources:
@@ -312,10 +322,76 @@ Common::SeekableReadStream *BaseFileManager::openPkgFile(const Common::String &f
 	if (!entry) {
 		return nullptr;
 	}
+	// The package sets only contain BaseFileEntries
+	const BaseFileEntry *fileEntry = (const BaseFileEntry *)entry.get();
+	if (!_detectionMode && fileEntry->_compressedLength != 0 && fileEntry->_length <= PKG_CACHE_MAX_FILE_SIZE) {
+		return openCachedPkgFile(fileEntry);
+	}
 	file = entry->createReadStream();
 	return file;
 }
 
+//////////////////////////////////////////////////////////////////////////
+static Common::SeekableReadStream *copyToMemoryStream(const byte *buffer, uint32 size) {
+	byte *data = (byte *)malloc(size);
+	if (!data) {
+		return nullptr;
+	}
+	memcpy(data, buffer, size);
+	return new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+Common::SeekableReadStream *BaseFileManager::openCachedPkgFile(const BaseFileEntry *entry) {
+	for (Common::List<CachedPkgFile>::iterator it = _pkgCache.begin(); it != _pkgCache.end(); ++it) {
+		if (it->_entry == entry) {
+			CachedPkgFile cached = *it;
+			if (it != _pkgCache.begin()) {
+				_pkgCache.erase(it);
+				_pkgCache.push_front(cached);
+			}
+			return copyToMemoryStream(cached._data, cached._size);
+		}
+	}
+
+	Common::SeekableReadStream *stream = entry->createReadStream();
+	if (!stream || entry->_length == 0) {
+		return stream;
+	}
+
+	CachedPkgFile cached;
+	cached._entry = entry;
+	cached._size = entry->_length;
+	cached._data = new byte[cached._size];
+	if (stream->read(cached._data, cached._size) != cached._size || stream->err()) {
+		// Let the caller deal with the broken stream as before
+		delete[] cached._data;
+		stream->seek(0);
+		return stream;
+	}
+	delete stream;
+
+	_pkgCache.push_front(cached);
+	_pkgCacheSize += cached._size;
+	while (_pkgCacheSize > PKG_CACHE_BUDGET) {
+		CachedPkgFile &oldest = _pkgCache.back();
+		_pkgCacheSize -= oldest._size;
+		delete[] oldest._data;
+		_pkgCache.pop_back();
+	}
+
+	return copyToMemoryStream(cached._data, cached._size);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void BaseFileManager::clearPkgCache() {
+	for (Common::List<CachedPkgFile>::iterator it = _pkgCache.begin(); it != _pkgCache.end(); ++it) {
+		delete[] it->_data;
+	}
+	_pkgCache.clear();
+	_pkgCacheSize = 0;
+}
+
 bool BaseFileManager::hasFile(const Common::String &filename) {
 	if (scumm_strnicmp(filename.c_str(), "savegame:", 9) == 0) {
 		BasePersistenceManager pm(BaseEngine::instance().getGameTargetName());
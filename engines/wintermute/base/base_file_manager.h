@@ -34,8 +34,10 @@
 #include "common/fs.h"
 #include "common/file.h"
 #include "common/language.h"
+#include "common/list.h"
 
 namespace Wintermute {
+class BaseFileEntry;
 class BaseFileManager {
 public:
 	bool cleanup();
@@ -62,6 +64,8 @@ private:
 	void initResources();
 	Common::SeekableReadStream *openFileRaw(const Common::String &filename);
 	Common::SeekableReadStream *openPkgFile(const Common::String &filename);
+	Common::SeekableReadStream *openCachedPkgFile(const BaseFileEntry *entry);
+	void clearPkgCache();
 	Common::FSList _packagePaths;
 	bool registerPackage(Common::FSNode package, const Common::String &filename = "", bool searchSignature = false);
 	bool _detectionMode;
@@ -69,6 +73,15 @@ private:
 	Common::Array<Common::SeekableReadStream *> _openFiles;
 	Common::Language _language;
 	Common::Archive *_resources;
+
+	// Recently decompressed package members, most recently used first
+	struct CachedPkgFile {
+		const BaseFileEntry *_entry;
+		byte *_data;
+		uint32 _size;
+	};
+	Common::List<CachedPkgFile> _pkgCache;
+	uint32 _pkgCacheSize;
 	// This class is intentionally not a subclass of Base, as it needs to be used by
 	// the detector too, without launching the entire engine:
 };
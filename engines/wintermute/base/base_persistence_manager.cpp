@@ -31,6 +31,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_persistence_manager.h"
+#include "engines/wintermute/base/saveload.h"
 #include "engines/wintermute/platform_osystem.h"
 #include "engines/wintermute/math/vector2.h"
 #include "engines/wintermute/base/gfx/base_image.h"
@@ -61,6 +62,8 @@ BasePersistenceManager::BasePersistenceManager(const Common::String &savePrefix,
 	_offset = 0;
 	_saveStream = nullptr;
 	_loadStream = nullptr;
+	_pendingFile = nullptr;
+	_pendingOffset = 0;
 	_deleteSingleton = deleteSingleton;
 	if (BaseEngine::instance().getGameRef()) {
 		_gameRef = BaseEngine::instance().getGameRef();
@@ -103,6 +106,9 @@ BasePersistenceManager::BasePersistenceManager(const Common::String &savePrefix,
 
 //////////////////////////////////////////////////////////////////////////
 BasePersistenceManager::~BasePersistenceManager() {
+	if (_pendingFile) {
+		finishSaveFile();
+	}
 	cleanup();
 	if (_deleteSingleton && BaseEngine::instance().getGameRef() == nullptr)
 		BaseEngine::destroy();
@@ -190,10 +196,12 @@ void BasePersistenceManager::getSaveStateDesc(int slot, SaveStateDescriptor &des
 
 void BasePersistenceManager::deleteSaveSlot(int slot) {
 	Common::String filename = getFilenameForSlot(slot);
+	SaveLoad::flushPendingSave();
 	g_system->getSavefileManager()->removeSavefile(filename);
 }
 
 uint32 BasePersistenceManager::getMaxUsedSlot() {
+	SaveLoad::flushPendingSave();
 	Common::String saveMask = Common::String::format("%s.???", _savePrefix.c_str());
 	Common::StringArray saves = g_system->getSavefileManager()->listSavefiles(saveMask);
 	Common::StringArray::iterator it = saves.begin();
@@ -312,6 +320,9 @@ bool BasePersistenceManager::initSave(const Common::String &desc) {
 }
 
 bool BasePersistenceManager::readHeader(const Common::String &filename) {
+	// Make sure a savegame that is still being written is complete on disk.
+	SaveLoad::flushPendingSave();
+
 	cleanup();
 
 	_saving = false;
@@ -417,18 +428,66 @@ bool BasePersistenceManager::initLoad(const Common::String &filename) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BasePersistenceManager::saveFile(const Common::String &filename) {
-	byte *prefixBuffer = _richBuffer;
-	uint32 prefixSize = _richBufferSize;
+	if (!startSaveFile(filename)) {
+		return false;
+	}
+	return finishSaveFile();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Opens the savefile and writes the header prefix; the serialized state is
+// then written out by continueSaveFile() in chunks, so that the compression
+// done by the savefile stream can be spread over several frames.
+bool BasePersistenceManager::startSaveFile(const Common::String &filename) {
+	if (_pendingFile || !_saveStream) {
+		return false;
+	}
+
+	Common::SaveFileManager *saveMan = ((WintermuteEngine *)g_engine)->getSaveFileMan();
+	_pendingFile = saveMan->openForSaving(filename);
+	if (!_pendingFile) {
+		return false;
+	}
+	_pendingOffset = 0;
+	_pendingFile->write(_richBuffer, _richBufferSize);
+	return !_pendingFile->err();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Writes at most maxBytes of the pending savegame, returns true once
+// everything has been handed to the savefile (or writing failed).
+bool BasePersistenceManager::continueSaveFile(uint32 maxBytes) {
+	if (!_pendingFile) {
+		return true;
+	}
+
 	byte *buffer = ((Common::MemoryWriteStreamDynamic *)_saveStream)->getData();
 	uint32 bufferSize = ((Common::MemoryWriteStreamDynamic *)_saveStream)->size();
 
-	Common::SaveFileManager *saveMan = ((WintermuteEngine *)g_engine)->getSaveFileMan();
-	Common::OutSaveFile *file = saveMan->openForSaving(filename);
-	file->write(prefixBuffer, prefixSize);
-	file->write(buffer, bufferSize);
-	bool retVal = !file->err();
-	file->finalize();
-	delete file;
+	uint32 chunk = MIN(maxBytes, bufferSize - _pendingOffset);
+	if (chunk > 0) {
+		_pendingFile->write(buffer + _pendingOffset, chunk);
+		_pendingOffset += chunk;
+	}
+	return _pendingOffset >= bufferSize || _pendingFile->err();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool BasePersistenceManager::finishSaveFile() {
+	if (!_pendingFile) {
+		return false;
+	}
+
+	continueSaveFile(0xFFFFFFFF);
+	bool retVal = !_pendingFile->err();
+	_pendingFile->finalize();
+	retVal = retVal && !_pendingFile->err();
+	delete _pendingFile;
+	_pendingFile = nullptr;
+	_pendingOffset = 0;
 	return retVal;
 }
 
@@ -48,6 +48,10 @@ public:
 	Common::String _savePrefix;
 	Common::String _savedName;
 	bool saveFile(const Common::String &filename);
+	bool startSaveFile(const Common::String &filename);
+	bool continueSaveFile(uint32 maxBytes);
+	bool finishSaveFile();
+	bool isSaveFilePending() const { return _pendingFile != nullptr; }
 	uint32 getDWORD();
 	void putDWORD(uint32 val);
 	char *getString();
@@ -102,6 +106,8 @@ private:
 	bool putTimeDate(const TimeDate &t);
 	Common::WriteStream *_saveStream;
 	Common::SeekableReadStream *_loadStream;
+	Common::WriteStream *_pendingFile;
+	uint32 _pendingOffset;
 	TimeDate _savedTimestamp;
 	uint32 _savedPlayTime;
 	byte _savedVerMajor;
@@ -28,12 +28,17 @@
 
 #include "engines/wintermute/base/file/base_file_entry.h"
 #include "engines/wintermute/base/file/base_package.h"
+#include "common/memstream.h"
 #include "common/stream.h"
 #include "common/substream.h"
 #include "common/zlib.h"
 
 namespace Wintermute {
 
+// Uncompressed members up to this size are read in one go and served from
+// memory, instead of going through a substream of the package file.
+#define MAX_MEMORY_MEMBER_SIZE (256 * 1024)
+
 Common::SeekableReadStream *BaseFileEntry::createReadStream() const {
 	Common::SeekableReadStream *file = _package->getFilePointer();
 	if (!file) {
@@ -43,7 +48,17 @@ Common::SeekableReadStream *BaseFileEntry::createReadStream() const {
 	bool compressed = (_compressedLength != 0);
 
 	if (compressed) {
-		file = Common::wrapCompressedReadStream(new Common::SeekableSubReadStream(file, _offset, _offset + _length, DisposeAfterUse::YES), _length); //
+		file = Common::wrapCompressedReadStream(new Common::SeekableSubReadStream(file, _offset, _offset + _compressedLength, DisposeAfterUse::YES), _length); //
+	} else if (_length > 0 && _length <= MAX_MEMORY_MEMBER_SIZE) {
+		byte *data = (byte *)malloc(_length);
+		file->seek(_offset, SEEK_SET);
+		uint32 bytesRead = data ? file->read(data, _length) : 0;
+		delete file;
+		if (bytesRead != _length) {
+			free(data);
+			return nullptr;
+		}
+		return new Common::MemoryReadStream(data, _length, DisposeAfterUse::YES);
 	} else {
 		file = new Common::SeekableSubReadStream(file, _offset, _offset + _length, DisposeAfterUse::YES);
 	}
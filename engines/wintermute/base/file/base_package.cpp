@@ -30,6 +30,7 @@
 #include "engines/wintermute/base/file/base_file_entry.h"
 #include "engines/wintermute/base/file/dcpackage.h"
 #include "engines/wintermute/wintermute.h"
+#include "common/bufferedstream.h"
 #include "common/file.h"
 #include "common/stream.h"
 #include "common/debug.h"
@@ -108,6 +109,8 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 	if (!stream) {
 		return;
 	}
+	// The directory is parsed with many small reads, buffer them
+	stream = Common::wrapBufferedSeekableReadStream(stream, 16 * 1024, DisposeAfterUse::YES);
 	if (searchSignature) {
 		uint32 offset;
 		if (!findPackageSignature(stream, &offset)) {
@@ -55,9 +55,7 @@ BaseFontTT::BaseFontTT(BaseGame *inGame) : BaseFont(inGame) {
 	_fallbackFont = nullptr;
 	_deletableFont = nullptr;
 
-	for (int i = 0; i < NUM_CACHED_TEXTS; i++) {
-		_cachedTexts[i] = nullptr;
-	}
+	_cachedTextsSize = 0;
 
 	_lineHeight = 0;
 	_maxCharWidth = _maxCharHeight = 0;
@@ -82,12 +80,36 @@ BaseFontTT::~BaseFontTT(void) {
 
 //////////////////////////////////////////////////////////////////////////
 void BaseFontTT::clearCache() {
-	for (int i = 0; i < NUM_CACHED_TEXTS; i++) {
-		if (_cachedTexts[i]) {
-			delete _cachedTexts[i];
-		}
-		_cachedTexts[i] = nullptr;
+	for (CachedTextList::iterator it = _cachedTexts.begin(); it != _cachedTexts.end(); ++it) {
+		delete *it;
 	}
+	_cachedTexts.clear();
+	_cachedTextsSize = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void BaseFontTT::trimCache() {
+	uint32 count = _cachedTexts.size();
+	while (_cachedTextsSize > TEXT_CACHE_BUDGET && count > NUM_CACHED_TEXTS) {
+		BaseCachedTTFontText *cachedText = _cachedTexts.back();
+		_cachedTexts.pop_back();
+		_cachedTextsSize -= cachedText->_size;
+		delete cachedText;
+		count--;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+uint32 BaseFontTT::computeTextHash(const WideString &text, int width, TTextAlign align, int maxHeight, int maxLength) {
+	uint32 hash = 2166136261u;
+	for (uint32 i = 0; i < text.size(); i++) {
+		hash = (hash ^ text[i]) * 16777619u;
+	}
+	hash = (hash ^ (uint32)width) * 16777619u;
+	hash = (hash ^ (uint32)align) * 16777619u;
+	hash = (hash ^ (uint32)maxHeight) * 16777619u;
+	hash = (hash ^ (uint32)maxLength) * 16777619u;
+	return hash;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -95,16 +117,16 @@ void BaseFontTT::initLoop() {
 	// we need more aggressive cache management on iOS not to waste too much memory on fonts
 	if (_gameRef->_constrainedMemory) {
 		// purge all cached images not used in the last frame
-		for (int i = 0; i < NUM_CACHED_TEXTS; i++) {
-			if (_cachedTexts[i] == nullptr) {
-				continue;
-			}
-
-			if (!_cachedTexts[i]->_marked) {
-				delete _cachedTexts[i];
-				_cachedTexts[i] = nullptr;
+		CachedTextList::iterator it = _cachedTexts.begin();
+		while (it != _cachedTexts.end()) {
+			BaseCachedTTFontText *cachedText = *it;
+			if (!cachedText->_marked) {
+				_cachedTextsSize -= cachedText->_size;
+				delete cachedText;
+				it = _cachedTexts.erase(it);
 			} else {
-				_cachedTexts[i]->_marked = false;
+				cachedText->_marked = false;
+				++it;
 			}
 		}
 	}
@@ -174,28 +196,24 @@ void BaseFontTT::drawText(const byte *text, int x, int y, int width, TTextAlign
 	BaseRenderer *renderer = _gameRef->_renderer;
 
 	// find cached surface, if exists
-	uint32 minUseTime = UINT_MAX;
-	int minIndex = -1;
 	BaseSurface *surface = nullptr;
 	int textOffset = 0;
-
-	for (int i = 0; i < NUM_CACHED_TEXTS; i++) {
-		if (_cachedTexts[i] == nullptr) {
-			minUseTime = 0;
-			minIndex = i;
-		} else {
-			if (_cachedTexts[i]->_text == textStr && _cachedTexts[i]->_align == align && _cachedTexts[i]->_width == width && _cachedTexts[i]->_maxHeight == maxHeight && _cachedTexts[i]->_maxLength == maxLength) {
-				surface = _cachedTexts[i]->_surface;
-				textOffset = _cachedTexts[i]->_textOffset;
-				_cachedTexts[i]->_marked = true;
-				_cachedTexts[i]->_lastUsed = g_system->getMillis();
-				break;
-			} else {
-				if (_cachedTexts[i]->_lastUsed < minUseTime) {
-					minUseTime = _cachedTexts[i]->_lastUsed;
-					minIndex = i;
-				}
+	uint32 hash = computeTextHash(textStr, width, align, maxHeight, maxLength);
+
+	for (CachedTextList::iterator it = _cachedTexts.begin(); it != _cachedTexts.end(); ++it) {
+		BaseCachedTTFontText *cachedText = *it;
+		if (cachedText->_hash == hash && cachedText->_text == textStr && cachedText->_align == align && cachedText->_width == width && cachedText->_maxHeight == maxHeight && cachedText->_maxLength == maxLength) {
+			surface = cachedText->_surface;
+			textOffset = cachedText->_textOffset;
+			cachedText->_marked = true;
+			cachedText->_lastUsed = g_system->getMillis();
+
+			// move it to the front
+			if (it != _cachedTexts.begin()) {
+				_cachedTexts.erase(it);
+				_cachedTexts.push_front(cachedText);
 			}
+			break;
 		}
 	}
 
@@ -205,20 +223,23 @@ void BaseFontTT::drawText(const byte *text, int x, int y, int width, TTextAlign
 		surface = renderTextToTexture(textStr, width, align, maxHeight, textOffset);
 		if (surface) {
 			// write surface to cache
-			if (_cachedTexts[minIndex] != nullptr) {
-				delete _cachedTexts[minIndex];
-			}
-			_cachedTexts[minIndex] = new BaseCachedTTFontText;
-
-			_cachedTexts[minIndex]->_surface = surface;
-			_cachedTexts[minIndex]->_align = align;
-			_cachedTexts[minIndex]->_width = width;
-			_cachedTexts[minIndex]->_maxHeight = maxHeight;
-			_cachedTexts[minIndex]->_maxLength = maxLength;
-			_cachedTexts[minIndex]->_text = textStr;
-			_cachedTexts[minIndex]->_textOffset = textOffset;
-			_cachedTexts[minIndex]->_marked = true;
-			_cachedTexts[minIndex]->_lastUsed = g_system->getMillis();
+			BaseCachedTTFontText *cachedText = new BaseCachedTTFontText;
+
+			cachedText->_surface = surface;
+			cachedText->_align = align;
+			cachedText->_width = width;
+			cachedText->_maxHeight = maxHeight;
+			cachedText->_maxLength = maxLength;
+			cachedText->_text = textStr;
+			cachedText->_textOffset = textOffset;
+			cachedText->_marked = true;
+			cachedText->_lastUsed = g_system->getMillis();
+			cachedText->_hash = hash;
+			cachedText->_size = surface->getWidth() * surface->getHeight() * 4;
+
+			_cachedTexts.push_front(cachedText);
+			_cachedTextsSize += cachedText->_size;
+			trimCache();
 		}
 	}
 
@@ -541,9 +562,7 @@ bool BaseFontTT::persist(BasePersistenceManager *persistMgr) {
 	}
 
 	if (!persistMgr->getIsSaving()) {
-		for (int i = 0; i < NUM_CACHED_TEXTS; i++) {
-			_cachedTexts[i] = nullptr;
-		}
+		_cachedTextsSize = 0;
 		_fallbackFont = _font = _deletableFont = nullptr;
 	}
 
@@ -33,10 +33,14 @@
 #include "engines/wintermute/base/font/base_font.h"
 #include "engines/wintermute/base/gfx/base_surface.h"
 #include "common/rect.h"
+#include "common/list.h"
 #include "graphics/surface.h"
 #include "graphics/font.h"
 
+// Rendered texts are kept until they take up more than TEXT_CACHE_BUDGET
+// bytes, but at least the NUM_CACHED_TEXTS most recently used ones are kept
 #define NUM_CACHED_TEXTS 30
+#define TEXT_CACHE_BUDGET (4 * 1024 * 1024)
 
 namespace Wintermute {
 
@@ -55,6 +59,8 @@ private:
 		int32 _textOffset;
 		bool _marked;
 		uint32 _lastUsed;
+		uint32 _hash;
+		uint32 _size;
 
 		BaseCachedTTFontText() : _text() {
 			//_text = L"";
@@ -64,6 +70,8 @@ private:
 			_textOffset = 0;
 			_lastUsed = 0;
 			_marked = false;
+			_hash = 0;
+			_size = 0;
 		}
 
 		virtual ~BaseCachedTTFontText() {
@@ -121,7 +129,13 @@ private:
 
 	BaseSurface *renderTextToTexture(const WideString &text, int width, TTextAlign align, int maxHeight, int &textOffset);
 
-	BaseCachedTTFontText *_cachedTexts[NUM_CACHED_TEXTS];
+	// most recently used first
+	typedef Common::List<BaseCachedTTFontText *> CachedTextList;
+	CachedTextList _cachedTexts;
+	uint32 _cachedTextsSize;
+
+	static uint32 computeTextHash(const WideString &text, int width, TTextAlign align, int maxHeight, int maxLength);
+	void trimCache();
 
 	bool initFont();
 
@@ -28,6 +28,7 @@
 
 #include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "engines/wintermute/base/gfx/osystem/base_surface_osystem.h"
+#include "engines/wintermute/base/gfx/osystem/dirty_rect_container.h"
 #include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 #include "engines/wintermute/base/base_surface_storage.h"
 #include "engines/wintermute/base/gfx/base_image.h"
@@ -57,7 +58,10 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
+	_dirtyRects = new DirtyRectContainer();
+	_spriteBatchDepth = 0;
+	_spriteBatchRects = new DirtyRectContainer();
+	_showDirtyRects = false;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -72,10 +76,11 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 	while (it != _renderQueue.end()) {
 		RenderTicket *ticket = *it;
 		it = _renderQueue.erase(it);
-		delete ticket;
+		deleteTicket(ticket);
 	}
 
-	delete _dirtyRect;
+	delete _dirtyRects;
+	delete _spriteBatchRects;
 
 	_renderSurface->free();
 	delete _renderSurface;
@@ -154,8 +159,9 @@ bool BaseRenderOSystem::indicatorFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects->reset();
+		// Still erase the outlines shown last frame, or they would stay
+		updateDirtyRectOverlay();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -178,7 +184,7 @@ bool BaseRenderOSystem::flip() {
 			if ((*it)->_wantsDraw == false) {
 				RenderTicket *ticket = *it;
 				it = _renderQueue.erase(it);
-				delete ticket;
+				deleteTicket(ticket);
 			} else {
 				(*it)->_wantsDraw = false;
 				++it;
@@ -194,13 +200,12 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects->reset();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
 
+	updateDirtyRectOverlay();
 	g_system->updateScreen();
 
 	return STATUS_OK;
@@ -271,7 +276,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -284,26 +289,41 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 	}
 
 	if (owner) { // Fade-tickets are owner-less
-		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
+		uint32 hash = RenderTicket::computeHash(owner, srcRect, dstRect, transform);
+		TicketHashIndex::const_iterator bucket = _ticketsByHash.find(hash);
+
+		// Only go through the queue if there is a ticket from last frame
+		// to reuse, which is not the case for new or changed draw calls.
+		bool found = false;
+		if (bucket != _ticketsByHash.end()) {
+			const Common::Array<RenderTicket *> &tickets = bucket->_value;
+			for (uint i = 0; i < tickets.size(); i++) {
+				if (!tickets[i]->_wantsDraw && tickets[i]->_isValid && tickets[i]->matches(owner, srcRect, dstRect, transform)) {
+					found = true;
+					break;
+				}
+			}
+		}
+
+		if (found) {
+			// Tickets not drawn yet this frame all come after _lastFrameIter,
+			// the one we look for is usually right there.
+			RenderQueueIterator it = _lastFrameIter;
+			++it;
+			// Avoid calling end() and operator* every time, when potentially going through
+			// LOTS of tickets.
+			RenderQueueIterator endIterator = _renderQueue.end();
+			RenderTicket *compareTicket = nullptr;
+			for (; it != endIterator; ++it) {
+				compareTicket = *it;
+				if (compareTicket->getHash() == hash && compareTicket->_isValid && compareTicket->matches(owner, srcRect, dstRect, transform)) {
 					drawFromQueuedTicket(it);
+					return;
 				}
-				return;
 			}
 		}
 	}
-	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+	RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
 	if (!_disableDirtyRects) {
 		drawFromTicket(ticket);
 	} else {
@@ -320,12 +340,73 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
-	RenderQueueIterator it;
-	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-		if ((*it)->_owner == surf) {
-			invalidateTicket(*it);
+	TicketOwnerIndex::const_iterator entry = _ticketsByOwner.find(surf);
+	if (entry == _ticketsByOwner.end()) {
+		return;
+	}
+
+	const Common::Array<RenderTicket *> &tickets = entry->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		invalidateTicket(tickets[i]);
+	}
+}
+
+RenderTicket *BaseRenderOSystem::createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
+	// Sprites moving across the screen keep copying the same part of the
+	// same surface, share that copy instead.
+	const RenderTicket *surfaceSource = nullptr;
+	if (owner && surf) {
+		TicketOwnerIndex::const_iterator entry = _ticketsByOwner.find(owner);
+		if (entry != _ticketsByOwner.end()) {
+			const Common::Array<RenderTicket *> &tickets = entry->_value;
+			for (uint i = 0; i < tickets.size(); i++) {
+				if (tickets[i]->canShareSurface(owner, srcRect, dstRect, transform)) {
+					surfaceSource = tickets[i];
+					break;
+				}
+			}
+		}
+	}
+
+	RenderTicket *ticket = new (_ticketPool) RenderTicket(owner, surf, srcRect, dstRect, transform, surfaceSource);
+	if (owner) {
+		_ticketsByHash[ticket->getHash()].push_back(ticket);
+		_ticketsByOwner[owner].push_back(ticket);
+	}
+	return ticket;
+}
+
+static void removeTicketFromIndex(Common::Array<RenderTicket *> &tickets, RenderTicket *ticket) {
+	for (uint i = 0; i < tickets.size(); i++) {
+		if (tickets[i] == ticket) {
+			// Order doesn't matter, move the last one here
+			tickets[i] = tickets.back();
+			tickets.pop_back();
+			return;
+		}
+	}
+}
+
+void BaseRenderOSystem::deleteTicket(RenderTicket *ticket) {
+	if (ticket->_owner) {
+		TicketHashIndex::iterator bucket = _ticketsByHash.find(ticket->getHash());
+		if (bucket != _ticketsByHash.end()) {
+			removeTicketFromIndex(bucket->_value, ticket);
+			if (bucket->_value.empty()) {
+				_ticketsByHash.erase(bucket);
+			}
+		}
+
+		TicketOwnerIndex::iterator entry = _ticketsByOwner.find(ticket->_owner);
+		if (entry != _ticketsByOwner.end()) {
+			removeTicketFromIndex(entry->_value, ticket);
+			if (entry->_value.empty()) {
+				_ticketsByOwner.erase(entry);
+			}
 		}
 	}
+
+	_ticketPool.deleteChunk(ticket);
 }
 
 void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
@@ -365,12 +446,11 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	if (_spriteBatchDepth > 0) {
+		_spriteBatchRects->addDirtyRect(rect, _renderRect);
+		return;
 	}
-	_dirtyRect->clip(_renderRect);
+	_dirtyRects->addDirtyRect(rect, _renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -384,12 +464,13 @@ void BaseRenderOSystem::drawTickets() {
 			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
 			it = _renderQueue.erase(it);
-			delete ticket;
+			deleteTicket(ticket);
 		} else {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	_overlayRects.clear();
+	if (_dirtyRects->isEmpty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -399,43 +480,68 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
+	const Common::Array<Common::Rect> &dirtyRects = _dirtyRects->getOptimized();
+	DirtyRectStats frameStats;
+	frameStats._frames = 1;
+	frameStats._rects = dirtyRects.size();
+
 	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
+	const RenderTicket *opaqueTicket = nullptr;
 	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+		opaqueTicket = *it;
+	}
+	for (uint i = 0; i < dirtyRects.size(); i++) {
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+		if (!opaqueTicket || !opaqueTicket->_dstRect.contains(dirtyRects[i])) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirtyRects[i], _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		frameStats._pixels += dirtyRects[i].width() * dirtyRects[i].height();
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+		for (uint i = 0; i < dirtyRects.size(); i++) {
+			if (ticket->_dstRect.intersects(dirtyRects[i])) {
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(dirtyRects[i]);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				_needsFlip = true;
+
+				frameStats._ticketDraws++;
+				frameStats._ticketPixels += pos.width() * pos.height();
+			}
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	for (uint i = 0; i < dirtyRects.size(); i++) {
+		const Common::Rect &rect = dirtyRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(rect.left, rect.top), _renderSurface->pitch, rect.left, rect.top, rect.width(), rect.height());
+	}
+
+	if (_showDirtyRects) {
+		_overlayRects = dirtyRects;
+	}
+
+	_lastFrameStats = frameStats;
+	_totalStats._frames += frameStats._frames;
+	_totalStats._rects += frameStats._rects;
+	_totalStats._pixels += frameStats._pixels;
+	_totalStats._ticketPixels += frameStats._ticketPixels;
+	_totalStats._ticketDraws += frameStats._ticketDraws;
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -444,7 +550,7 @@ void BaseRenderOSystem::drawTickets() {
 			RenderTicket *ticket = *it;
 			addDirtyRect((*it)->_dstRect);
 			it = _renderQueue.erase(it);
-			delete ticket;
+			deleteTicket(ticket);
 		} else {
 			++it;
 		}
@@ -452,6 +558,38 @@ void BaseRenderOSystem::drawTickets() {
 
 }
 
+void BaseRenderOSystem::resetStats() {
+	_lastFrameStats = DirtyRectStats();
+	_totalStats = DirtyRectStats();
+}
+
+void BaseRenderOSystem::updateDirtyRectOverlay() {
+	for (uint i = 0; i < _shownOverlayRects.size(); i++) {
+		const Common::Rect &rect = _shownOverlayRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(rect.left, rect.top), _renderSurface->pitch, rect.left, rect.top, rect.width(), rect.height());
+	}
+	_shownOverlayRects.clear();
+
+	if (!_showDirtyRects || _overlayRects.empty()) {
+		return;
+	}
+
+	// The outlines go straight to the screen, so that they never end up in
+	// the render surface the next frames are based on.
+	Graphics::Surface *screen = g_system->lockScreen();
+	if (!screen) {
+		return;
+	}
+	uint32 color = screen->format.ARGBToColor(255, 255, 0, 255);
+	for (uint i = 0; i < _overlayRects.size(); i++) {
+		screen->frameRect(_overlayRects[i], color);
+	}
+	g_system->unlockScreen();
+
+	_shownOverlayRects = _overlayRects;
+	_overlayRects.clear();
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void BaseRenderOSystem::drawFromSurface(RenderTicket *ticket) {
 	ticket->drawToSurface(_renderSurface);
@@ -569,7 +707,7 @@ void BaseRenderOSystem::endSaveLoad() {
 	while (it != _renderQueue.end()) {
 		RenderTicket *ticket = *it;
 		it = _renderQueue.erase(it);
-		delete ticket;
+		deleteTicket(ticket);
 	}
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
@@ -582,10 +720,24 @@ void BaseRenderOSystem::endSaveLoad() {
 }
 
 bool BaseRenderOSystem::startSpriteBatch() {
+	_spriteBatchDepth++;
 	return STATUS_OK;
 }
 
 bool BaseRenderOSystem::endSpriteBatch() {
+	if (_spriteBatchDepth == 0 || --_spriteBatchDepth > 0) {
+		return STATUS_OK;
+	}
+
+	// Particles are many small tickets, often overlapping. Joined on their
+	// own, they take up a few entries of the dirty rect list instead of
+	// using up its limit and making the whole frame fall back to a single
+	// bounding rect.
+	const Common::Array<Common::Rect> &rects = _spriteBatchRects->getOptimized();
+	for (uint i = 0; i < rects.size(); i++) {
+		_dirtyRects->addDirtyRect(rects[i], _renderRect);
+	}
+	_spriteBatchRects->reset();
 	return STATUS_OK;
 }
 
@@ -32,12 +32,16 @@
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "common/rect.h"
 #include "graphics/surface.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/list.h"
+#include "common/memorypool.h"
 #include "graphics/transform_struct.h"
+#include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 
 namespace Wintermute {
 class BaseSurfaceOSystem;
-class RenderTicket;
+class DirtyRectContainer;
 /**
  * A 2D-renderer implementation for WME.
  * This renderer makes use of a "ticket"-system, where all draw-calls
@@ -112,6 +116,30 @@ public:
 	void endSaveLoad();
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
+
+	struct DirtyRectStats {
+		uint32 _frames;
+		uint32 _rects;
+		uint32 _pixels;       // Pixels cleared and uploaded to the backend
+		uint32 _ticketPixels; // Pixels drawn from tickets
+		uint32 _ticketDraws;
+
+		DirtyRectStats() : _frames(0), _rects(0), _pixels(0), _ticketPixels(0), _ticketDraws(0) {}
+	};
+	/**
+	 * Statistics of the dirty rects of the last frame, which changed anything.
+	 */
+	const DirtyRectStats &getLastFrameStats() const { return _lastFrameStats; }
+	/**
+	 * Statistics of the dirty rects summed up since the last resetStats().
+	 */
+	const DirtyRectStats &getTotalStats() const { return _totalStats; }
+	void resetStats();
+	/**
+	 * Outline the dirty rects of every frame on screen, for debugging.
+	 */
+	void setShowDirtyRects(bool show) { _showDirtyRects = show; }
+	bool getShowDirtyRects() const { return _showDirtyRects; }
 private:
 	/**
 	 * Mark a specified rect of the screen as dirty.
@@ -122,13 +150,38 @@ private:
 	 * Traverse the tickets that are dirty, and draw them
 	 */
 	void drawTickets();
+	/**
+	 * Allocate a new ticket and add it to the ticket indices. The ticket
+	 * shares its surface copy with an existing ticket where possible.
+	 */
+	RenderTicket *createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
+	/**
+	 * Remove a ticket from the ticket indices and free it.
+	 * Does not remove the ticket from the render queue.
+	 */
+	void deleteTicket(RenderTicket *ticket);
 	// Non-dirty-rects:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	/**
+	 * Restore the screen below the last dirty rect outlines and draw the new ones
+	 */
+	void updateDirtyRectOverlay();
+	DirtyRectContainer *_dirtyRects;
+	// Dirty rects of the tickets drawn between startSpriteBatch() and
+	// endSpriteBatch(), they are joined and added to _dirtyRects at the end
+	int _spriteBatchDepth;
+	DirtyRectContainer *_spriteBatchRects;
 	Common::List<RenderTicket *> _renderQueue;
 
+	typedef Common::HashMap<uint32, Common::Array<RenderTicket *> > TicketHashIndex;
+	typedef Common::HashMap<BaseSurfaceOSystem *, Common::Array<RenderTicket *> > TicketOwnerIndex;
+	// All queued tickets with an owner, by RenderTicket::getHash() and by owner
+	TicketHashIndex _ticketsByHash;
+	TicketOwnerIndex _ticketsByOwner;
+	Common::ObjectPool<RenderTicket> _ticketPool;
+
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
 	Common::Rect _renderRect;
@@ -147,6 +200,12 @@ private:
 
 	bool _skipThisFrame;
 	int _lastScreenChangeID; // previous value of OSystem::getScreenChangeID()
+
+	DirtyRectStats _lastFrameStats;
+	DirtyRectStats _totalStats;
+	bool _showDirtyRects;
+	Common::Array<Common::Rect> _overlayRects;      // Dirty rects of the current frame
+	Common::Array<Common::Rect> _shownOverlayRects; // Dirty rects outlined on screen
 };
 
 } // End of namespace Wintermute
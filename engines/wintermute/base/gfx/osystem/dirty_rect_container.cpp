@@ -0,0 +1,166 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/wintermute/base/gfx/osystem/dirty_rect_container.h"
+
+namespace Wintermute {
+
+static inline int32 rectArea(const Common::Rect &rect) {
+	return (int32)rect.width() * rect.height();
+}
+
+DirtyRectContainer::DirtyRectContainer() : _fallback(false), _optimizedValid(false) {
+}
+
+void DirtyRectContainer::addDirtyRect(const Common::Rect &rect, const Common::Rect &clipRect) {
+	Common::Rect clipped(rect);
+	clipped.clip(clipRect);
+	if (clipped.isEmpty()) {
+		return;
+	}
+
+	_optimizedValid = false;
+
+	if (_bounding.isEmpty()) {
+		_bounding = clipped;
+	} else {
+		_bounding.extend(clipped);
+	}
+
+	if (_fallback) {
+		return;
+	}
+
+	for (uint i = 0; i < _rects.size(); i++) {
+		if (_rects[i].contains(clipped)) {
+			return;
+		}
+	}
+	_rects.push_back(clipped);
+
+	if (_rects.size() > kMaxRects) {
+		_fallback = true;
+		_rects.clear();
+	}
+}
+
+void DirtyRectContainer::reset() {
+	_rects.clear();
+	_optimized.clear();
+	_bounding = Common::Rect();
+	_fallback = false;
+	_optimizedValid = false;
+}
+
+const Common::Array<Common::Rect> &DirtyRectContainer::getOptimized() {
+	if (_optimizedValid) {
+		return _optimized;
+	}
+
+	_optimized.clear();
+	if (_fallback) {
+		_optimized.push_back(_bounding);
+	} else {
+		joinRects();
+		for (uint i = 0; i < _rects.size(); i++) {
+			insertDisjoint(_rects[i], 0);
+		}
+	}
+
+	_optimizedValid = true;
+	return _optimized;
+}
+
+uint32 DirtyRectContainer::getArea() {
+	const Common::Array<Common::Rect> &rects = getOptimized();
+	uint32 area = 0;
+	for (uint i = 0; i < rects.size(); i++) {
+		area += rectArea(rects[i]);
+	}
+	return area;
+}
+
+void DirtyRectContainer::joinRects() {
+	// Join any two rects, where the bounding rect of both costs at most
+	// kMaxMergeWaste pixels not covered by either of them.
+	bool joined;
+	do {
+		joined = false;
+		for (uint i = 0; i < _rects.size(); i++) {
+			for (uint j = i + 1; j < _rects.size(); j++) {
+				Common::Rect bounding(_rects[i]);
+				bounding.extend(_rects[j]);
+
+				Common::Rect overlap(_rects[i]);
+				overlap.clip(_rects[j]);
+
+				int32 waste = rectArea(bounding) - rectArea(_rects[i]) - rectArea(_rects[j]);
+				if (!overlap.isEmpty()) {
+					waste += rectArea(overlap);
+				}
+
+				if (waste <= kMaxMergeWaste) {
+					_rects[i] = bounding;
+					_rects.remove_at(j);
+					joined = true;
+					j = i;
+				}
+			}
+		}
+	} while (joined);
+}
+
+void DirtyRectContainer::insertDisjoint(const Common::Rect &rect, uint first) {
+	for (uint i = first; i < _optimized.size(); i++) {
+		const Common::Rect existing = _optimized[i];
+
+		if (existing.contains(rect)) {
+			return;
+		}
+		if (!existing.intersects(rect)) {
+			continue;
+		}
+
+		// Only add the parts of the rect not covered yet, none of them
+		// can intersect the rects before this one.
+		Common::Rect overlap(existing);
+		overlap.clip(rect);
+
+		if (rect.top < existing.top) {
+			insertDisjoint(Common::Rect(rect.left, rect.top, rect.right, existing.top), i + 1);
+		}
+		if (rect.bottom > existing.bottom) {
+			insertDisjoint(Common::Rect(rect.left, existing.bottom, rect.right, rect.bottom), i + 1);
+		}
+		if (rect.left < existing.left) {
+			insertDisjoint(Common::Rect(rect.left, overlap.top, existing.left, overlap.bottom), i + 1);
+		}
+		if (rect.right > existing.right) {
+			insertDisjoint(Common::Rect(existing.right, overlap.top, rect.right, overlap.bottom), i + 1);
+		}
+		return;
+	}
+
+	_optimized.push_back(rect);
+}
+
+} // End of namespace Wintermute
@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WINTERMUTE_DIRTY_RECT_CONTAINER_H
+#define WINTERMUTE_DIRTY_RECT_CONTAINER_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Wintermute {
+
+/**
+ * The set of screen regions that need to be redrawn in a frame.
+ * Rather than growing a single bounding rectangle, every change is kept
+ * as a separate rectangle, so that two small changes at opposite ends of
+ * the screen don't force a redraw of everything in between. Once there
+ * are too many of them the container falls back to their bounding
+ * rectangle.
+ */
+class DirtyRectContainer {
+public:
+	DirtyRectContainer();
+
+	/**
+	 * Add a rectangle, clipped to clipRect.
+	 */
+	void addDirtyRect(const Common::Rect &rect, const Common::Rect &clipRect);
+	void reset();
+
+	bool isEmpty() const { return _bounding.isEmpty(); }
+	/**
+	 * Get disjoint rectangles covering all that was added. They need to be
+	 * disjoint, as every ticket gets drawn once per rectangle it intersects
+	 * and alpha-blended tickets must not be drawn twice. Rectangles are
+	 * joined where this costs few extra pixels.
+	 */
+	const Common::Array<Common::Rect> &getOptimized();
+	/**
+	 * Get the bounding rectangle of all that was added.
+	 */
+	const Common::Rect &getBoundingRect() const { return _bounding; }
+	/**
+	 * Get the number of pixels covered by the optimized rectangles.
+	 */
+	uint32 getArea();
+
+private:
+	enum {
+		kMaxRects = 64,
+		kMaxMergeWaste = 2048 // Max. number of pixels added when joining two rects
+	};
+
+	void joinRects();
+	void insertDisjoint(const Common::Rect &rect, uint first);
+
+	Common::Array<Common::Rect> _rects;
+	Common::Array<Common::Rect> _optimized;
+	Common::Rect _bounding;
+	bool _fallback;
+	bool _optimizedValid;
+};
+
+} // End of namespace Wintermute
+
+#endif
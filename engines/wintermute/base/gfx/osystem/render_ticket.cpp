@@ -34,20 +34,26 @@
 
 namespace Wintermute {
 
-RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform) :
+RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct transform, const RenderTicket *surfaceSource) :
 	_owner(owner),
 	_srcRect(*srcRect),
 	_dstRect(*dstRect),
 	_isValid(true),
 	_wantsDraw(true),
 	_transform(transform) {
-	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
+	_hash = computeHash(owner, srcRect, dstRect, transform);
+
+	if (surf && surfaceSource) {
+		// The surface is never written to after its creation, so sharing
+		// it is safe.
+		_surface = surfaceSource->_surface;
+	} else if (surf) {
+		Graphics::Surface *surface = new Graphics::Surface();
+		surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+		assert(surface->format.bytesPerPixel == 4);
 		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
+		for (int i = 0; i < surface->h; i++) {
+			memcpy(surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * surface->format.bytesPerPixel);
 		}
 		// Then scale it if necessary
 		//
@@ -58,30 +64,25 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
 		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::TransparentSurface src(*_surface, false);
+			Graphics::TransparentSurface src(*surface, false);
 			Graphics::Surface *temp = src.rotoscale(transform);
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			surface->free();
+			delete surface;
+			surface = temp;
 		} else if ((dstRect->width() != srcRect->width() ||
 					dstRect->height() != srcRect->height()) &&
 					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::TransparentSurface src(*_surface, false);
+			Graphics::TransparentSurface src(*surface, false);
 			Graphics::Surface *temp = src.scale(dstRect->width(), dstRect->height());
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			surface->free();
+			delete surface;
+			surface = temp;
 		}
-	} else {
-		_surface = nullptr;
+		_surface = Common::SharedPtr<Graphics::Surface>(surface, Graphics::SharedPtrSurfaceDeleter());
 	}
 }
 
 RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
 }
 
 bool RenderTicket::operator==(const RenderTicket &t) const {
@@ -95,6 +96,47 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+bool RenderTicket::matches(BaseSurfaceOSystem *owner, const Common::Rect *srcRect, const Common::Rect *dstRect, const Graphics::TransformStruct &transform) const {
+	return _owner == owner && _transform == transform && _dstRect == *dstRect && _srcRect == *srcRect;
+}
+
+bool RenderTicket::canShareSurface(BaseSurfaceOSystem *owner, const Common::Rect *srcRect, const Common::Rect *dstRect, const Graphics::TransformStruct &transform) const {
+	if (!_isValid || !_surface || _owner != owner || _srcRect != *srcRect) {
+		return false;
+	}
+
+	// Rotated copies depend on the whole transform, scaled ones only on
+	// the size they were scaled to, see the constructor.
+	if (_transform._angle != Graphics::kDefaultAngle || transform._angle != Graphics::kDefaultAngle) {
+		return _transform == transform && _dstRect.width() == dstRect->width() && _dstRect.height() == dstRect->height();
+	}
+
+	bool scaled = (_dstRect.width() != _srcRect.width() || _dstRect.height() != _srcRect.height()) &&
+	              _transform._numTimesX * _transform._numTimesY == 1;
+	bool otherScaled = (dstRect->width() != srcRect->width() || dstRect->height() != srcRect->height()) &&
+	                   transform._numTimesX * transform._numTimesY == 1;
+	if (scaled != otherScaled) {
+		return false;
+	}
+	return !scaled || (_dstRect.width() == dstRect->width() && _dstRect.height() == dstRect->height());
+}
+
+uint32 RenderTicket::computeHash(BaseSurfaceOSystem *owner, const Common::Rect *srcRect, const Common::Rect *dstRect, const Graphics::TransformStruct &transform) {
+	// Only the most commonly differing values, matches() has the final say
+	uint32 hash = (uint32)(size_t)owner;
+	hash = hash * 31 + (uint16)srcRect->left;
+	hash = hash * 31 + (uint16)srcRect->top;
+	hash = hash * 31 + (uint16)srcRect->right;
+	hash = hash * 31 + (uint16)srcRect->bottom;
+	hash = hash * 31 + (uint16)dstRect->left;
+	hash = hash * 31 + (uint16)dstRect->top;
+	hash = hash * 31 + (uint16)dstRect->right;
+	hash = hash * 31 + (uint16)dstRect->bottom;
+	hash = hash * 31 + (uint32)transform._angle;
+	hash = hash * 31 + transform._rgbaMod;
+	return hash;
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	Graphics::TransparentSurface src(*getSurface(), false);
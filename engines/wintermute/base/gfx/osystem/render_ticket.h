@@ -31,11 +31,25 @@
 
 #include "graphics/transparent_surface.h"
 #include "graphics/surface.h"
+#include "common/func.h"
+#include "common/ptr.h"
 #include "common/rect.h"
 
 namespace Wintermute {
-
 class BaseSurfaceOSystem;
+}
+
+namespace Common {
+template<typename T> struct Hash;
+template<> struct Hash<Wintermute::BaseSurfaceOSystem *> : public UnaryFunction<Wintermute::BaseSurfaceOSystem *, uint> {
+	uint operator()(Wintermute::BaseSurfaceOSystem *val) const {
+		return (uint)((size_t)val);
+	}
+};
+}
+
+namespace Wintermute {
+
 /**
  * A single RenderTicket.
  * A render ticket is a collection of the data and draw specifications made
@@ -51,10 +65,15 @@ class BaseSurfaceOSystem;
  */
 class RenderTicket {
 public:
-	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
-	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
+	/**
+	 * Create a ticket. The ticket shares the surface copy of surfaceSource,
+	 * if given, which must have been created from the same surface data.
+	 * @see canShareSurface
+	 */
+	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform, const RenderTicket *surfaceSource = nullptr);
+	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()), _hash(0) {}
 	~RenderTicket();
-	const Graphics::Surface *getSurface() const { return _surface; }
+	const Graphics::Surface *getSurface() const { return _surface.get(); }
 	// Non-dirty-rects:
 	void drawToSurface(Graphics::Surface *_targetSurface) const;
 	// Dirty-rects:
@@ -69,10 +88,26 @@ public:
 
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
+	/**
+	 * Check whether this ticket was made by a draw call with the given arguments
+	 */
+	bool matches(BaseSurfaceOSystem *owner, const Common::Rect *srcRect, const Common::Rect *dstRect, const Graphics::TransformStruct &transform) const;
+	/**
+	 * Check whether a draw call with the given arguments would end up with
+	 * the same surface copy as this ticket, as long as the owner didn't change.
+	 */
+	bool canShareSurface(BaseSurfaceOSystem *owner, const Common::Rect *srcRect, const Common::Rect *dstRect, const Graphics::TransformStruct &transform) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
+
+	/**
+	 * Hash of the arguments compared by matches(), for looking up tickets
+	 */
+	static uint32 computeHash(BaseSurfaceOSystem *owner, const Common::Rect *srcRect, const Common::Rect *dstRect, const Graphics::TransformStruct &transform);
+	uint32 getHash() const { return _hash; }
 private:
-	Graphics::Surface *_surface;
+	Common::SharedPtr<Graphics::Surface> _surface;
 	Common::Rect _srcRect;
+	uint32 _hash;
 };
 
 } // End of namespace Wintermute
@@ -320,9 +320,9 @@ bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
 
 //////////////////////////////////////////////////////////////////////////
 bool PartEmitter::display(BaseRegion *region) {
-	if (_sprites.size() <= 1) {
-		BaseEngine::getRenderer()->startSpriteBatch();
-	}
+	// The renderer merges the screen updates of the whole batch, which
+	// doesn't depend on all particles using the same sprite
+	BaseEngine::getRenderer()->startSpriteBatch();
 
 	for (uint32 i = 0; i < _particles.size(); i++) {
 		if (region != nullptr && _useRegion) {
@@ -334,9 +334,7 @@ bool PartEmitter::display(BaseRegion *region) {
 		_particles[i]->display(this);
 	}
 
-	if (_sprites.size() <= 1) {
-		BaseEngine::getRenderer()->endSpriteBatch();
-	}
+	BaseEngine::getRenderer()->endSpriteBatch();
 
 	return STATUS_OK;
 }
@@ -43,9 +43,17 @@
 
 namespace Wintermute {
 
+// Amount of savegame data handed to the (compressing) savefile per frame
+#define SAVE_WRITE_CHUNK_SIZE (128 * 1024)
+
+BasePersistenceManager *SaveLoad::_pendingSave = nullptr;
+int SaveLoad::_pendingSaveSlot = -1;
+
 bool SaveLoad::loadGame(const Common::String &filename, BaseGame *gameRef) {
 	gameRef->LOG(0, "Loading game '%s'...", filename.c_str());
 
+	flushPendingSave();
+
 	bool ret;
 
 	gameRef->stopVideo();
@@ -91,6 +99,8 @@ bool SaveLoad::saveGame(int slot, const char *desc, bool quickSave, BaseGame *ga
 
 	gameRef->applyEvent("BeforeSave", true);
 
+	flushPendingSave();
+
 	bool ret;
 
 	BasePersistenceManager *pm = new BasePersistenceManager();
@@ -99,8 +109,18 @@ bool SaveLoad::saveGame(int slot, const char *desc, bool quickSave, BaseGame *ga
 		if (DID_SUCCEED(ret = SystemClassRegistry::getInstance()->saveTable(gameRef,  pm, quickSave))) {
 			if (DID_SUCCEED(ret = SystemClassRegistry::getInstance()->saveInstances(gameRef,  pm, quickSave))) {
 				pm->putDWORD(BaseEngine::instance().getRandomSource()->getSeed());
-				if (DID_SUCCEED(ret = pm->saveFile(filename))) {
-					ConfMan.setInt("most_recent_saveslot", slot);
+				// Only the object graph is walked synchronously, the data is
+				// compressed and written out over the next frames. The save
+				// counts as done for the script once it is queued, as the
+				// state it captured can no longer change; a failed write is
+				// reported by finishPendingSave().
+				if (pm->startSaveFile(filename)) {
+					_pendingSave = pm;
+					_pendingSaveSlot = slot;
+					pm = nullptr;
+					ret = STATUS_OK;
+				} else {
+					ret = STATUS_FAILED;
 				}
 			}
 		}
@@ -113,6 +133,38 @@ bool SaveLoad::saveGame(int slot, const char *desc, bool quickSave, BaseGame *ga
 	return ret;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void SaveLoad::updatePendingSave() {
+	if (_pendingSave && _pendingSave->continueSaveFile(SAVE_WRITE_CHUNK_SIZE)) {
+		finishPendingSave();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool SaveLoad::flushPendingSave() {
+	if (_pendingSave) {
+		return finishPendingSave();
+	}
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool SaveLoad::finishPendingSave() {
+	BasePersistenceManager *pm = _pendingSave;
+	_pendingSave = nullptr;
+
+	bool ret = pm->finishSaveFile();
+	if (ret) {
+		ConfMan.setInt("most_recent_saveslot", _pendingSaveSlot);
+	} else {
+		warning("SaveLoad::finishPendingSave - Failed to write savegame for slot %d", _pendingSaveSlot);
+	}
+	_pendingSaveSlot = -1;
+
+	delete pm;
+	return ret;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool SaveLoad::initAfterLoad() {
 	SystemClassRegistry::getInstance()->enumInstances(afterLoadRegion,   "BaseRegion",   nullptr);
@@ -194,6 +246,7 @@ bool SaveLoad::isSaveSlotUsed(int slot) {
 }
 
 bool SaveLoad::emptySaveSlot(int slot) {
+	flushPendingSave();
 	Common::String filename = getSaveSlotFilename(slot);
 	BasePersistenceManager *pm = new BasePersistenceManager();
 	((WintermuteEngine *)g_engine)->getSaveFileMan()->removeSavefile(pm->getFilenameForSlot(slot));
@@ -33,6 +33,7 @@
 
 namespace Wintermute {
 class BaseGame;
+class BasePersistenceManager;
 class SaveLoad {
 public:
 	static bool emptySaveSlot(int slot);
@@ -42,6 +43,8 @@ public:
 
 	static bool loadGame(const Common::String &filename, BaseGame *gameRef);
 	static bool saveGame(int slot, const char *desc, bool quickSave, BaseGame *gameRef);
+	static void updatePendingSave();
+	static bool flushPendingSave();
 	static bool initAfterLoad();
 	static void afterLoadScene(void *scene, void *data);
 	static void afterLoadRegion(void *region, void *data);
@@ -50,6 +53,11 @@ private:
 	static void afterLoadSound(void *sound, void *data);
 	static void afterLoadFont(void *font, void *data);
 	static void afterLoadScript(void *script, void *data);
+	static bool finishPendingSave();
+
+	// Savegame whose serialized state is still being written to disk
+	static BasePersistenceManager *_pendingSave;
+	static int _pendingSaveSlot;
 };
 
 } // End of namespace Wintermute
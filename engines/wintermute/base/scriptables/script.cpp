@@ -29,7 +29,9 @@
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/base/scriptables/script.h"
 #include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/scriptables/script_engine.h"
+#include "engines/wintermute/base/scriptables/script_symbol_table.h"
 #include "engines/wintermute/base/scriptables/script_stack.h"
 #include "common/memstream.h"
 #if EXTENDED_DEBUGGER_ENABLED
@@ -48,6 +50,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 	_currentLine = 0;
 
 	_symbols = nullptr;
+	_symbolIds = nullptr;
 	_numSymbols = 0;
 
 	_engine = engine;
@@ -176,6 +179,13 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	// resolve the symbols once, so variable access doesn't hash names
+	ScSymbolTable *symbolTable = BaseEngine::instance().getSymbolTable();
+	_symbolIds = new uint32[_numSymbols];
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		_symbolIds[i] = symbolTable->intern(_symbols[i]);
+	}
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -396,6 +406,8 @@ void ScScript::cleanup() {
 		delete[] _symbols;
 	}
 	_symbols = nullptr;
+	delete[] _symbolIds;
+	_symbolIds = nullptr;
 	_numSymbols = 0;
 
 	if (_globals && !_thread) {
@@ -533,9 +545,9 @@ bool ScScript::executeInstruction() {
 		_operand->setNULL();
 		dw = getDWORD();
 		if (_scopeStack->_sP < 0) {
-			_globals->setProp(_symbols[dw], _operand);
+			_globals->setSymbolProp(_symbolIds[dw], _operand);
 		} else {
-			_scopeStack->getTop()->setProp(_symbols[dw], _operand);
+			_scopeStack->getTop()->setSymbolProp(_symbolIds[dw], _operand);
 		}
 
 		break;
@@ -545,9 +557,9 @@ bool ScScript::executeInstruction() {
 		dw = getDWORD();
 		/*      char *temp = _symbols[dw]; // TODO delete */
 		// only create global var if it doesn't exist
-		if (!_engine->_globals->propExists(_symbols[dw])) {
+		if (!_engine->_globals->symbolPropExists(_symbolIds[dw])) {
 			_operand->setNULL();
-			_engine->_globals->setProp(_symbols[dw], _operand, false, inst == II_DEF_CONST_VAR);
+			_engine->_globals->setSymbolProp(_symbolIds[dw], _operand, false, inst == II_DEF_CONST_VAR);
 		}
 		break;
 	}
@@ -603,6 +615,9 @@ bool ScScript::executeInstruction() {
 		// we are already calling this method, try native
 		if (_thread && _methodThread && strcmp(methodName, _threadEvent) == 0 && var->_type == VAL_NATIVE && _owner == var->getNative()) {
 			triedNative = true;
+			if (_engine->getIsProfiling()) {
+				_engine->addNativeCall(this, var->_valNative->getClassName(), methodName);
+			}
 			res = var->_valNative->scCallMethod(this, _stack, _thisStack, methodName);
 		}
 
@@ -651,6 +666,9 @@ bool ScScript::executeInstruction() {
 			else {
 				res = STATUS_FAILED;
 				if (var->_type == VAL_NATIVE && !triedNative) {
+					if (_engine->getIsProfiling()) {
+						_engine->addNativeCall(this, var->_valNative->getClassName(), methodName);
+					}
 					res = var->_valNative->scCallMethod(this, _stack, _thisStack, methodName);
 				}
 
@@ -669,6 +687,9 @@ bool ScScript::executeInstruction() {
 		uint32 symbolIndex = getDWORD();
 
 		TExternalFunction *f = getExternal(_symbols[symbolIndex]);
+		if (_engine->getIsProfiling()) {
+			_engine->addNativeCall(this, f ? "external" : "Game", _symbols[symbolIndex]);
+		}
 		if (f) {
 			externalCall(_stack, _thisStack, f);
 		} else {
@@ -697,7 +718,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		if (false && /*var->_type==VAL_OBJECT ||*/ var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
 			_stack->push(_operand);
@@ -708,15 +729,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -769,7 +789,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -1128,27 +1148,33 @@ uint32 ScScript::getMethodPos(const Common::String &name) const {
 
 //////////////////////////////////////////////////////////////////////////
 ScValue *ScScript::getVar(char *name) {
+	return getVarBySymbol(BaseEngine::instance().getSymbolTable()->intern(name), name);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVar(uint32 symbolIndex) {
+	return getVarBySymbol(_symbolIds[symbolIndex], _symbols[symbolIndex]);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVarBySymbol(uint32 symbol, const char *name) {
 	ScValue *ret = nullptr;
 
 	// scope locals
 	if (_scopeStack->_sP >= 0) {
-		if (_scopeStack->getTop()->propExists(name)) {
-			ret = _scopeStack->getTop()->getProp(name);
-		}
+		ret = _scopeStack->getTop()->getSymbolProp(symbol);
 	}
 
 	// script globals
 	if (ret == nullptr) {
-		if (_globals->propExists(name)) {
-			ret = _globals->getProp(name);
-		}
+		ret = _globals->getSymbolProp(symbol);
 	}
 
 	// engine globals
 	if (ret == nullptr) {
-		if (_engine->_globals->propExists(name)) {
-			ret = _engine->_globals->getProp(name);
-		}
+		ret = _engine->_globals->getSymbolProp(symbol);
 	}
 
 	if (ret == nullptr) {
@@ -1157,11 +1183,11 @@ ScValue *ScScript::getVar(char *name) {
 		ScValue *val = new ScValue(_gameRef);
 		ScValue *scope = _scopeStack->getTop();
 		if (scope) {
-			scope->setProp(name, val);
-			ret = _scopeStack->getTop()->getProp(name);
+			scope->setSymbolProp(symbol, val);
+			ret = _scopeStack->getTop()->getSymbolProp(symbol);
 		} else {
-			_globals->setProp(name, val);
-			ret = _globals->getProp(name);
+			_globals->setSymbolProp(symbol, val);
+			ret = _globals->getSymbolProp(symbol);
 		}
 		delete val;
 	}
@@ -80,6 +80,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getVar(uint32 symbolIndex);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -152,6 +153,8 @@ public:
 	bool externalCall(ScStack *stack, ScStack *thisStack, ScScript::TExternalFunction *function);
 private:
 	char **_symbols;
+	// ScSymbolTable ids of _symbols
+	uint32 *_symbolIds;
 	uint32 _numSymbols;
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
@@ -164,6 +167,7 @@ private:
 
 	bool initScript();
 	bool initTables();
+	ScValue *getVarBySymbol(uint32 symbol, const char *name);
 
 	virtual void preInstHook(uint32 inst);
 	virtual void postInstHook(uint32 inst);
@@ -34,6 +34,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/utils/utils.h"
+#include "common/algorithm.h"
 
 namespace Wintermute {
 
@@ -76,6 +77,8 @@ ScEngine::ScEngine(BaseGame *inGame) : BaseClass(inGame) {
 
 	_isProfiling = false;
 	_profilingStartTime = 0;
+	_scriptBudget = 5;
+	_frameProfile._frames = _frameProfile._totalTime = _frameProfile._maxTime = _frameProfile._overBudget = 0;
 
 	//EnableProfiling();
 }
@@ -258,6 +261,7 @@ bool ScEngine::tick() {
 		return STATUS_OK;
 	}
 
+	uint32 frameStartTime = _isProfiling ? g_system->getMillis() : 0;
 
 	// resolve waiting scripts
 	for (uint32 i = 0; i < _scripts.size(); i++) {
@@ -334,12 +338,14 @@ bool ScEngine::tick() {
 		// time sliced script
 		if (_scripts[i]->_timeSlice > 0) {
 			uint32 startTime = g_system->getMillis();
+			uint32 instructions = 0;
 			while (_scripts[i]->_state == SCRIPT_RUNNING && g_system->getMillis() - startTime < _scripts[i]->_timeSlice) {
 				_currentScript = _scripts[i];
 				_scripts[i]->executeInstruction();
+				instructions++;
 			}
 			if (_isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i], g_system->getMillis() - startTime, instructions);
 			}
 		}
 
@@ -351,17 +357,29 @@ bool ScEngine::tick() {
 				startTime = g_system->getMillis();
 			}
 
+			uint32 instructions = 0;
 			while (_scripts[i]->_state == SCRIPT_RUNNING) {
 				_currentScript = _scripts[i];
 				_scripts[i]->executeInstruction();
+				instructions++;
 			}
 			if (isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i], g_system->getMillis() - startTime, instructions);
 			}
 		}
 		_currentScript = nullptr;
 	}
 
+	if (_isProfiling) {
+		uint32 frameTime = g_system->getMillis() - frameStartTime;
+		_frameProfile._frames++;
+		_frameProfile._totalTime += frameTime;
+		_frameProfile._maxTime = MAX(_frameProfile._maxTime, frameTime);
+		if (frameTime > _scriptBudget) {
+			_frameProfile._overBudget++;
+		}
+	}
+
 	removeFinishedScripts();
 
 	return STATUS_OK;
@@ -557,14 +575,47 @@ bool ScEngine::clearGlobals(bool includingNatives) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-void ScEngine::addScriptTime(const char *filename, uint32 time) {
+ScEngine::ScriptProfile &ScEngine::getScriptProfile(ScScript *script) {
+	AnsiString name = script->_filename;
+	name.toLowercase();
+	if (script->_thread && script->_threadEvent) {
+		name += Common::String::format(" (%s)", script->_threadEvent);
+	}
+
+	ScriptProfiles::iterator it = _scriptProfiles.find(name);
+	if (it != _scriptProfiles.end()) {
+		return it->_value;
+	}
+
+	ScriptProfile &profile = _scriptProfiles[name];
+	profile._runs = profile._instructions = profile._time = profile._nativeCalls = 0;
+	return profile;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::addScriptTime(ScScript *script, uint32 time, uint32 instructions) {
+	if (!_isProfiling) {
+		return;
+	}
+
+	ScriptProfile &profile = getScriptProfile(script);
+	profile._runs++;
+	profile._time += time;
+	profile._instructions += instructions;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::addNativeCall(ScScript *script, const char *className, const char *methodName) {
 	if (!_isProfiling) {
 		return;
 	}
 
-	AnsiString fileName = filename;
-	fileName.toLowercase();
-	_scriptTimes[fileName] += time;
+	if (script->_filename) {
+		getScriptProfile(script)._nativeCalls++;
+	}
+	_nativeCalls[Common::String::format("%s.%s", className, methodName)]++;
 }
 
 
@@ -574,10 +625,7 @@ void ScEngine::enableProfiling() {
 		return;
 	}
 
-	// destroy old data, if any
-	_scriptTimes.clear();
-
-	_profilingStartTime = g_system->getMillis();
+	resetProfiling();
 	_isProfiling = true;
 }
 
@@ -594,28 +642,102 @@ void ScEngine::disableProfiling() {
 
 
 //////////////////////////////////////////////////////////////////////////
-void ScEngine::dumpStats() {
-	error("DumpStats not ported to ScummVM yet");
-	/*  uint32 totalTime = g_system->getMillis() - _profilingStartTime;
+void ScEngine::resetProfiling() {
+	// destroy old data, if any
+	_scriptProfiles.clear();
+	_nativeCalls.clear();
+	_frameProfile._frames = _frameProfile._totalTime = _frameProfile._maxTime = _frameProfile._overBudget = 0;
 
-	    typedef std::vector <std::pair<uint32, std::string> > TimeVector;
-	    TimeVector times;
+	_profilingStartTime = g_system->getMillis();
+}
 
-	    ScriptTimes::iterator it;
-	    for (it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
-	        times.push_back(std::pair<uint32, std::string> (it->_value, it->_key));
-	    }
-	    std::sort(times.begin(), times.end());
 
+namespace {
 
-	    TimeVector::reverse_iterator tit;
+struct ProfileEntry {
+	const Common::String *_name;
+	const ScEngine::ScriptProfile *_profile;
+};
 
-	    _gameRef->LOG(0, "***** Script profiling information: *****");
-	    _gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
+bool compareProfileEntries(const ProfileEntry &entry1, const ProfileEntry &entry2) {
+	if (entry1._profile->_time != entry2._profile->_time) {
+		return entry1._profile->_time > entry2._profile->_time;
+	}
+	return entry1._profile->_instructions > entry2._profile->_instructions;
+}
+
+struct NativeCallEntry {
+	const Common::String *_name;
+	uint32 _calls;
+};
+
+bool compareNativeCallEntries(const NativeCallEntry &entry1, const NativeCallEntry &entry2) {
+	return entry1._calls > entry2._calls;
+}
 
-	    for (tit = times.rbegin(); tit != times.rend(); ++tit) {
-	        _gameRef->LOG(0, "  %-40s %fs (%f%%)", tit->second.c_str(), (float)tit->first / 1000, (float)tit->first / (float)totalTime * 100);
-	    }*/
+} // End of anonymous namespace
+
+//////////////////////////////////////////////////////////////////////////
+Common::String ScEngine::getProfilingReport(uint32 maxEntries) const {
+	uint32 totalTime = g_system->getMillis() - _profilingStartTime;
+	Common::String report;
+
+	report += Common::String::format("Profiling time: %.2fs, %s\n", (float)totalTime / 1000, _isProfiling ? "running" : "stopped");
+	if (_frameProfile._frames) {
+		report += Common::String::format("Script time per frame: %.2fms average, %dms max, %d of %d frames over the %dms budget\n",
+			(float)_frameProfile._totalTime / _frameProfile._frames, _frameProfile._maxTime,
+			_frameProfile._overBudget, _frameProfile._frames, _scriptBudget);
+	}
+
+	Common::Array<ProfileEntry> scripts;
+	for (ScriptProfiles::const_iterator it = _scriptProfiles.begin(); it != _scriptProfiles.end(); ++it) {
+		ProfileEntry entry;
+		entry._name = &it->_key;
+		entry._profile = &it->_value;
+		scripts.push_back(entry);
+	}
+	Common::sort(scripts.begin(), scripts.end(), compareProfileEntries);
+
+	report += "Scripts:\n";
+	report += Common::String::format("  %-48s %8s %8s %12s %8s\n", "name", "time(ms)", "runs", "instructions", "natives");
+	for (uint32 i = 0; i < scripts.size() && (maxEntries == 0 || i < maxEntries); i++) {
+		const ScriptProfile *profile = scripts[i]._profile;
+		report += Common::String::format("  %-48s %8d %8d %12d %8d\n", scripts[i]._name->c_str(),
+			profile->_time, profile->_runs, profile->_instructions, profile->_nativeCalls);
+	}
+
+	Common::Array<NativeCallEntry> natives;
+	for (NativeCalls::const_iterator it = _nativeCalls.begin(); it != _nativeCalls.end(); ++it) {
+		NativeCallEntry entry;
+		entry._name = &it->_key;
+		entry._calls = it->_value;
+		natives.push_back(entry);
+	}
+	Common::sort(natives.begin(), natives.end(), compareNativeCallEntries);
+
+	report += "Native methods:\n";
+	for (uint32 i = 0; i < natives.size() && (maxEntries == 0 || i < maxEntries); i++) {
+		report += Common::String::format("  %-48s %8d\n", natives[i]._name->c_str(), natives[i]._calls);
+	}
+
+	return report;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::dumpStats() {
+	_gameRef->LOG(0, "***** Script profiling information: *****");
+
+	Common::String report = getProfilingReport();
+	const char *line = report.c_str();
+	while (*line) {
+		const char *end = strchr(line, '\n');
+		if (!end) {
+			end = line + strlen(line);
+		}
+		_gameRef->LOG(0, "%s", Common::String(line, end).c_str());
+		line = *end ? end + 1 : end;
+	}
 }
 
 } // End of namespace Wintermute
@@ -96,13 +96,46 @@ public:
 
 	BaseArray<ScScript *> _scripts;
 
+	/** Statistics of one script file, or of one event/method thread of it */
+	struct ScriptProfile {
+		uint32 _runs;
+		uint32 _instructions;
+		uint32 _time;
+		uint32 _nativeCalls;
+	};
+
+	/** Time spent in tick() each frame */
+	struct FrameProfile {
+		uint32 _frames;
+		uint32 _totalTime;
+		uint32 _maxTime;
+		uint32 _overBudget;
+	};
+
 	void enableProfiling();
 	void disableProfiling();
+	void resetProfiling();
 	bool getIsProfiling() {
 		return _isProfiling;
 	}
 
-	void addScriptTime(const char *filename, uint32 Time);
+	void addScriptTime(ScScript *script, uint32 time, uint32 instructions);
+	void addNativeCall(ScScript *script, const char *className, const char *methodName);
+
+	/** Frames where the scripts take longer than this (in ms) are counted */
+	void setScriptBudget(uint32 budget) {
+		_scriptBudget = budget;
+	}
+	uint32 getScriptBudget() const {
+		return _scriptBudget;
+	}
+
+	/**
+	 * Return the profiling results as text, the most expensive scripts
+	 * and native methods first. maxEntries limits the length of each list,
+	 * 0 lists everything.
+	 */
+	Common::String getProfilingReport(uint32 maxEntries = 0) const;
 	void dumpStats();
 
 private:
@@ -110,9 +143,15 @@ private:
 	CScCachedScript *_cachedScripts[MAX_CACHED_SCRIPTS];
 	bool _isProfiling;
 	uint32 _profilingStartTime;
+	uint32 _scriptBudget;
+
+	typedef Common::HashMap<Common::String, ScriptProfile> ScriptProfiles;
+	ScriptProfiles _scriptProfiles;
+	typedef Common::HashMap<Common::String, uint32> NativeCalls;
+	NativeCalls _nativeCalls;
+	FrameProfile _frameProfile;
 
-	typedef Common::HashMap<Common::String, uint32> ScriptTimes;
-	ScriptTimes _scriptTimes;
+	ScriptProfile &getScriptProfile(ScScript *script);
 
 };
 
@@ -0,0 +1,71 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "engines/wintermute/base/scriptables/script_symbol_table.h"
+
+namespace Wintermute {
+
+//////////////////////////////////////////////////////////////////////////
+ScSymbolTable::ScSymbolTable() {
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScSymbolTable::~ScSymbolTable() {
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScSymbolTable::intern(const char *name) {
+	Common::String key(name);
+
+	SymbolMap::const_iterator it = _ids.find(key);
+	if (it != _ids.end()) {
+		return it->_value;
+	}
+
+	uint32 symbol = _names.size();
+	_ids[key] = symbol;
+	_names.push_back(_ids.find(key)->_key.c_str());
+	return symbol;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScSymbolTable::lookup(const char *name) const {
+	SymbolMap::const_iterator it = _ids.find(name);
+	if (it != _ids.end()) {
+		return it->_value;
+	}
+	return kInvalidSymbol;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+const char *ScSymbolTable::getName(uint32 symbol) const {
+	if (symbol >= _names.size()) {
+		return "";
+	}
+	return _names[symbol];
+}
+
+} // End of namespace Wintermute
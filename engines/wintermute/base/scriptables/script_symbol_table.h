@@ -0,0 +1,66 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef WINTERMUTE_SCSYMBOLTABLE_H
+#define WINTERMUTE_SCSYMBOLTABLE_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/str.h"
+
+namespace Wintermute {
+
+/**
+ * Interned script identifiers.
+ * Variable and property names are mapped to small integer ids once, so
+ * that the script VM and ScValue property maps can look them up without
+ * hashing the name again. The ids only live in memory; savegames keep
+ * storing the names.
+ */
+class ScSymbolTable {
+public:
+	static const uint32 kInvalidSymbol = 0xFFFFFFFF;
+
+	ScSymbolTable();
+	~ScSymbolTable();
+
+	/** Returns the id of the given name, assigning a new one if needed. */
+	uint32 intern(const char *name);
+	/** Returns the id of the given name, or kInvalidSymbol if it was never interned. */
+	uint32 lookup(const char *name) const;
+	/** Returns the name of an interned id. */
+	const char *getName(uint32 symbol) const;
+
+	uint32 size() const { return _names.size(); }
+
+private:
+	typedef Common::HashMap<Common::String, uint32> SymbolMap;
+
+	SymbolMap _ids;
+	// points into the keys of _ids, which never move
+	Common::Array<const char *> _names;
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -28,9 +28,11 @@
 
 #include "engines/wintermute/platform_osystem.h"
 #include "engines/wintermute/base/base_dynamic_buffer.h"
+#include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/base/scriptables/script.h"
+#include "engines/wintermute/base/scriptables/script_symbol_table.h"
 #include "engines/wintermute/utils/string_util.h"
 #include "engines/wintermute/base/base_scriptable.h"
 
@@ -183,7 +185,7 @@ ScValue *ScValue::getProp(const char *name) {
 	}
 
 	if (ret == nullptr) {
-		_valIter = _valObject.find(name);
+		_valIter = _valObject.find(BaseEngine::instance().getSymbolTable()->lookup(name));
 		if (_valIter != _valObject.end()) {
 			ret = _valIter->_value;
 		}
@@ -191,13 +193,32 @@ ScValue *ScValue::getProp(const char *name) {
 	return ret;
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::getSymbolProp(uint32 symbol) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->getSymbolProp(symbol);
+	}
+
+	_valIter = _valObject.find(symbol);
+	if (_valIter == _valObject.end()) {
+		return nullptr;
+	}
+
+	// natives and strings may answer the property themselves
+	if ((_type == VAL_NATIVE && _valNative) || _type == VAL_STRING) {
+		return getProp(BaseEngine::instance().getSymbolTable()->getName(symbol));
+	}
+	return _valIter->_value;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::deleteProp(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
 		return _valRef->deleteProp(name);
 	}
 
-	_valIter = _valObject.find(name);
+	_valIter = _valObject.find(BaseEngine::instance().getSymbolTable()->lookup(name));
 	if (_valIter != _valObject.end()) {
 		delete _valIter->_value;
 		_valIter->_value = nullptr;
@@ -220,25 +241,7 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 	}
 
 	if (DID_FAIL(ret)) {
-		ScValue *newVal = nullptr;
-
-		_valIter = _valObject.find(name);
-		if (_valIter != _valObject.end()) {
-			newVal = _valIter->_value;
-		}
-		if (!newVal) {
-			newVal = new ScValue(_gameRef);
-		} else {
-			newVal->cleanup();
-		}
-
-		newVal->copy(val, copyWhole);
-		newVal->_isConstVar = setAsConst;
-		_valObject[name] = newVal;
-
-		if (_type != VAL_NATIVE) {
-			_type = VAL_OBJECT;
-		}
+		storeProp(BaseEngine::instance().getSymbolTable()->intern(name), val, copyWhole, setAsConst);
 
 		/*
 		_valIter = _valObject.find(Name);
@@ -259,12 +262,58 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::setSymbolProp(uint32 symbol, ScValue *val, bool copyWhole, bool setAsConst) {
+	if (_type == VAL_VARIABLE_REF || (_type == VAL_NATIVE && _valNative)) {
+		return setProp(BaseEngine::instance().getSymbolTable()->getName(symbol), val, copyWhole, setAsConst);
+	}
+
+	storeProp(symbol, val, copyWhole, setAsConst);
+	return STATUS_OK;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScValue::storeProp(uint32 symbol, ScValue *val, bool copyWhole, bool setAsConst) {
+	ScValue *newVal = nullptr;
+
+	_valIter = _valObject.find(symbol);
+	if (_valIter != _valObject.end()) {
+		newVal = _valIter->_value;
+	}
+	if (!newVal) {
+		newVal = new ScValue(_gameRef);
+		_valObject[symbol] = newVal;
+	} else {
+		newVal->cleanup();
+	}
+
+	newVal->copy(val, copyWhole);
+	newVal->_isConstVar = setAsConst;
+
+	if (_type != VAL_NATIVE) {
+		_type = VAL_OBJECT;
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::propExists(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
 		return _valRef->propExists(name);
 	}
-	_valIter = _valObject.find(name);
+	_valIter = _valObject.find(BaseEngine::instance().getSymbolTable()->lookup(name));
+
+	return (_valIter != _valObject.end());
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::symbolPropExists(uint32 symbol) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->symbolPropExists(symbol);
+	}
+	_valIter = _valObject.find(symbol);
 
 	return (_valIter != _valObject.end());
 }
@@ -799,6 +848,9 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 	persistMgr->transferSint32(TMEMBER(_valInt));
 	persistMgr->transferPtr(TMEMBER_PTR(_valNative));
 
+	// properties are stored by name, the symbol ids are only valid for
+	// this session
+	ScSymbolTable *symbols = BaseEngine::instance().getSymbolTable();
 	int32 size;
 	const char *str;
 	if (persistMgr->getIsSaving()) {
@@ -806,7 +858,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 		persistMgr->transferSint32("", &size);
 		_valIter = _valObject.begin();
 		while (_valIter != _valObject.end()) {
-			str = _valIter->_key.c_str();
+			str = symbols->getName(_valIter->_key);
 			persistMgr->transferConstChar("", &str);
 			persistMgr->transferPtr("", &_valIter->_value);
 
@@ -819,7 +871,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 			persistMgr->transferConstChar("", &str);
 			persistMgr->transferPtr("", &val);
 
-			_valObject[str] = val;
+			_valObject[symbols->intern(str)] = val;
 			delete[] str;
 		}
 	}
@@ -887,7 +939,7 @@ bool ScValue::saveAsText(BaseDynamicBuffer *buffer, int indent) {
 	_valIter = _valObject.begin();
 	while (_valIter != _valObject.end()) {
 		buffer->putTextIndent(indent, "PROPERTY {\n");
-		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", _valIter->_key.c_str());
+		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", BaseEngine::instance().getSymbolTable()->getName(_valIter->_key));
 		buffer->putTextIndent(indent + 2, "VALUE=\"%s\"\n", _valIter->_value->getString());
 		buffer->putTextIndent(indent, "}\n\n");
 
@@ -34,6 +34,7 @@
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
 #include "common/str.h"
+#include "common/hashmap.h"
 
 namespace Wintermute {
 
@@ -83,6 +84,12 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	// Variants taking an interned ScSymbolTable id, used by the script VM.
+	// getSymbolProp() returns nullptr for a property that doesn't exist, so
+	// it replaces a propExists()/getProp() pair.
+	bool setSymbolProp(uint32 symbol, ScValue *val, bool copyWhole = false, bool setAsConst = false);
+	ScValue *getSymbolProp(uint32 symbol);
+	bool symbolPropExists(uint32 symbol);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -90,6 +97,7 @@ private:
 	int32 _valInt;
 	double _valFloat;
 	char *_valString;
+	void storeProp(uint32 symbol, ScValue *val, bool copyWhole, bool setAsConst);
 public:
 	TValType _type;
 	ScValue(BaseGame *inGame);
@@ -98,8 +106,9 @@ public:
 	ScValue(BaseGame *inGame, double Val);
 	ScValue(BaseGame *inGame, const char *Val);
 	virtual ~ScValue();
-	Common::HashMap<Common::String, ScValue *> _valObject;
-	Common::HashMap<Common::String, ScValue *>::iterator _valIter;
+	// keyed by ScSymbolTable id
+	Common::HashMap<uint32, ScValue *> _valObject;
+	Common::HashMap<uint32, ScValue *>::iterator _valIter;
 
 	bool setProperty(const char *propName, int32 value);
 	bool setProperty(const char *propName, const char *value);
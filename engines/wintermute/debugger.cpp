@@ -23,6 +23,9 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/scriptables/script_engine.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -36,6 +39,8 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("dirty_rects", WRAP_METHOD(Console, Cmd_DirtyRects));
+	registerCmd("script_profile", WRAP_METHOD(Console, Cmd_ScriptProfile));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -308,6 +313,86 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_DirtyRects(int argc, const char **argv) {
+	// The OSystem renderer is the only one there is
+	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(BaseEngine::getRenderer());
+	if (!renderer) {
+		debugPrintf("No renderer\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		Common::String arg(argv[1]);
+		if (arg == "on" || arg == "off") {
+			renderer->setShowDirtyRects(arg == "on");
+		} else if (arg == "reset") {
+			renderer->resetStats();
+		} else {
+			debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+			return true;
+		}
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+		return true;
+	}
+
+	const BaseRenderOSystem::DirtyRectStats &last = renderer->getLastFrameStats();
+	const BaseRenderOSystem::DirtyRectStats &total = renderer->getTotalStats();
+	Rect32 viewport = renderer->getViewPort();
+	uint32 screenPixels = (viewport.right - viewport.left) * (viewport.bottom - viewport.top);
+
+	debugPrintf("Overlay: %s\n", renderer->getShowDirtyRects() ? "on" : "off");
+	debugPrintf("Last frame: %d rects, %d pixels redrawn, %d pixels from %d tickets\n",
+		last._rects, last._pixels, last._ticketPixels, last._ticketDraws);
+	if (total._frames) {
+		debugPrintf("Average over %d frames: %d rects, %d pixels redrawn (%d%% of the screen), %d pixels from %d tickets\n",
+			total._frames, total._rects / total._frames, total._pixels / total._frames,
+			screenPixels ? (int)((uint64)total._pixels * 100 / ((uint64)screenPixels * total._frames)) : 0,
+			total._ticketPixels / total._frames, total._ticketDraws / total._frames);
+	}
+	return true;
+}
+
+bool Console::Cmd_ScriptProfile(int argc, const char **argv) {
+	BaseGame *game = BaseEngine::instance().getGameRef();
+	if (!game || !game->_scEngine) {
+		debugPrintf("No game running\n");
+		return true;
+	}
+	ScEngine *scEngine = game->_scEngine;
+
+	Common::String arg = argc > 1 ? argv[1] : "report";
+	if (arg == "on" && argc == 2) {
+		scEngine->enableProfiling();
+		debugPrintf("Script profiling enabled\n");
+	} else if (arg == "off" && argc == 2) {
+		// this also writes the report to the game log
+		scEngine->disableProfiling();
+		debugPrintf("Script profiling disabled\n");
+	} else if (arg == "reset" && argc == 2) {
+		scEngine->resetProfiling();
+	} else if (arg == "budget" && argc == 3) {
+		scEngine->setScriptBudget(atoi(argv[2]));
+		debugPrintf("Script budget set to %dms per frame\n", scEngine->getScriptBudget());
+	} else if (arg == "report" && argc <= 3) {
+		debugPrintf("%s", scEngine->getProfilingReport(argc == 3 ? atoi(argv[2]) : 20).c_str());
+	} else if (arg == "dump" && argc == 3) {
+		Common::DumpFile outFile;
+		if (!outFile.open(argv[2])) {
+			debugPrintf("Can't open '%s' for writing\n", argv[2]);
+			return true;
+		}
+		Common::String report = scEngine->getProfilingReport();
+		outFile.write(report.c_str(), report.size());
+		outFile.finalize();
+		outFile.close();
+		debugPrintf("Script profile written to '%s'\n", argv[2]);
+	} else {
+		debugPrintf("Usage: %s [on|off|reset|budget <ms>|report [count]|dump <output file name>]\n", argv[0]);
+	}
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
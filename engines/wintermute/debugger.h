@@ -70,6 +70,14 @@ public:
 	bool Cmd_Help(int argc, const char **argv);
 	bool Cmd_ShowFps(int argc, const char **argv);
 	bool Cmd_DumpFile(int argc, const char **argv);
+	/**
+	 * Print dirty rect statistics, toggle the dirty rect overlay
+	 */
+	bool Cmd_DirtyRects(int argc, const char **argv);
+	/**
+	 * Control the script profiler and print or save its report
+	 */
+	bool Cmd_ScriptProfile(int argc, const char **argv);
 
 #if EXTENDED_DEBUGGER_ENABLED
 	/**
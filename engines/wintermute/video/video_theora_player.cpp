@@ -316,18 +316,7 @@ bool VideoTheoraPlayer::update() {
 			if (!_theoraDecoder->endOfVideo() && _theoraDecoder->getTimeToNextFrame() == 0) {
 				const Graphics::Surface *decodedFrame = _theoraDecoder->decodeNextFrame();
 				if (decodedFrame) {
-					if (decodedFrame->format == _surface.format && decodedFrame->pitch == _surface.pitch && decodedFrame->h == _surface.h) {
-						const byte *src = (const byte *)decodedFrame->getBasePtr(0, 0);
-						byte *dst = (byte *)_surface.getBasePtr(0, 0);
-						memcpy(dst, src, _surface.pitch * _surface.h);
-					} else {
-						_surface.free();
-						_surface.copyFrom(*decodedFrame);
-					}
-
-					if (_texture) {
-						writeVideo();
-					}
+					writeVideo(*decodedFrame);
 				}
 			}
 			return STATUS_OK;
@@ -361,18 +350,28 @@ uint32 VideoTheoraPlayer::getMovieTime() const {
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool VideoTheoraPlayer::writeVideo() {
+bool VideoTheoraPlayer::writeVideo(const Graphics::Surface &frame) {
 	if (!_texture) {
 		return STATUS_FAILED;
 	}
 
 	_texture->startPixelOp();
 
-	writeAlpha();
 	if (_alphaImage) {
+		// The alpha channel is patched in, so work on our own copy
+		if (frame.format == _surface.format && frame.pitch == _surface.pitch && frame.h == _surface.h) {
+			const byte *src = (const byte *)frame.getBasePtr(0, 0);
+			byte *dst = (byte *)_surface.getBasePtr(0, 0);
+			memcpy(dst, src, _surface.pitch * _surface.h);
+		} else {
+			_surface.free();
+			_surface.copyFrom(frame);
+		}
+		writeAlpha();
 		_texture->putSurface(_surface, true);
 	} else {
-		_texture->putSurface(_surface, false);
+		// Upload the decoder's frame directly, saving a full-frame copy
+		_texture->putSurface(frame, false);
 	}
 
 	//RenderFrame(_texture, &yuv);
@@ -39,6 +39,7 @@
 
 #include "engines/wintermute/base/sound/base_sound_manager.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/saveload.h"
 #include "engines/wintermute/base/gfx/base_renderer.h"
 #include "engines/wintermute/base/scriptables/script_engine.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
@@ -250,6 +251,7 @@ int WintermuteEngine::messageLoop() {
 			if (!_game->getSuspendedRendering()) {
 				_game->_renderer->flip();
 			}
+			SaveLoad::updatePendingSave();
 			if (_game->getIsLoading()) {
 				_game->loadGame(_game->_scheduledLoadSlot);
 			}
@@ -263,6 +265,7 @@ int WintermuteEngine::messageLoop() {
 		}
 	}
 
+	SaveLoad::flushPendingSave();
 	if (_game) {
 		delete _game;
 		_game = nullptr;
@@ -281,10 +284,21 @@ Common::Error WintermuteEngine::loadGameState(int slot) {
 }
 
 Common::Error WintermuteEngine::saveGameState(int slot, const Common::String &desc) {
-	BaseEngine::instance().getGameRef()->saveGame(slot, desc.c_str(), false);
+	// The GMM expects the savefile to be complete on return
+	if (DID_FAIL(BaseEngine::instance().getGameRef()->saveGame(slot, desc.c_str(), false)) || !SaveLoad::flushPendingSave()) {
+		return Common::kWritingFailed;
+	}
 	return Common::kNoError;
 }
 
+void WintermuteEngine::pauseEngineIntern(bool pause) {
+	// The GMM lists and deletes savefiles while paused
+	if (pause) {
+		SaveLoad::flushPendingSave();
+	}
+	Engine::pauseEngineIntern(pause);
+}
+
 bool WintermuteEngine::canSaveGameStateCurrently() {
 	return true;
 }
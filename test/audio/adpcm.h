@@ -0,0 +1,151 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/adpcm.h"
+
+#include "common/memstream.h"
+
+#include "helper.h"
+
+// Random block streams with valid headers are decoded in varying read sizes.
+// The checksums were recorded with the byte-wise decoders, which the block
+// decoders have to match.
+class ADPCMTestSuite : public CxxTest::TestSuite
+{
+private:
+	uint32 _seed;
+
+	byte *createData(Audio::ADPCMType type, uint32 size, int channels, uint32 blockAlign) {
+		byte *data = (byte *)malloc(size);
+		for (uint32 i = 0; i < size; ++i)
+			data[i] = nextRandom(_seed) & 0xff;
+
+		for (uint32 block = 0; blockAlign && block < size; block += blockAlign) {
+			byte *header = data + block;
+			const uint32 left = size - block;
+
+			switch (type) {
+			case Audio::kADPCMMSIma:
+				// Predictor and step index for each channel
+				for (int i = 0; i < channels && (uint32)(i * 4 + 4) <= left; ++i)
+					WRITE_LE_UINT16(header + i * 4 + 2, nextRandom(_seed) % 89);
+				break;
+			case Audio::kADPCMDK3:
+				if (left >= 16) {
+					WRITE_LE_UINT16(header + 2, 22050);
+					header[14] = nextRandom(_seed) % 89;
+					header[15] = nextRandom(_seed) % 89;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		return data;
+	}
+
+	Audio::SeekableAudioStream *createStream(Audio::ADPCMType type, uint32 size, int channels, uint32 blockAlign, uint32 missing) {
+		// The data may end before the given size
+		byte *data = createData(type, size - missing, channels, blockAlign);
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream(data, size - missing, DisposeAfterUse::YES);
+		return Audio::makeADPCMStream(stream, DisposeAfterUse::YES, size, type, 22050, channels, blockAlign);
+	}
+
+	uint32 decode(Audio::ADPCMType type, uint32 size, int channels, uint32 blockAlign, bool rewind, uint32 missing = 0) {
+		Audio::SeekableAudioStream *audioStream = createStream(type, size, channels, blockAlign, missing);
+
+		// Read sizes are multiples of the largest unit any decoder needs
+		static const int readSizes[] = { 16, 48, 1008, 4096 };
+		int16 buffer[4096];
+		uint32 hash = kFnvHashInit;
+
+		for (int pass = 0; pass < (rewind ? 2 : 1); ++pass) {
+			audioStream->rewind();
+			for (int i = 0; ; ++i) {
+				const int samples = audioStream->readBuffer(buffer, readSizes[i % ARRAYSIZE(readSizes)]);
+				if (samples <= 0)
+					break;
+				for (int j = 0; j < samples; ++j)
+					hash = fnvHash(hash, (uint16)buffer[j]);
+			}
+		}
+
+		delete audioStream;
+		return hash;
+	}
+
+public:
+	void test_ms_ima() {
+		_seed = 0x1234;
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMSIma, 3000, 1, 256, false), 1973341601u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMSIma, 100000, 2, 1024, false), 2668125176u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMSIma, 70001, 2, 512, true), 4107104837u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMSIma, 70000, 2, 512, false, 1003), 2231800652u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMSIma, 70000, 1, 512, false, 512 * 3), 3144140786u);
+	}
+
+	void test_ms_ima_partial_chunk() {
+		// A Microsoft IMA block is made of chunks of eight samples per
+		// channel. Reads which end within the last chunk of a truncated
+		// stream must still return all of its samples, as reads of whole
+		// chunks do.
+		static const int channels[] = { 1, 2 };
+		static const int readSizes[] = { 6, 10 };
+		for (int i = 0; i < ARRAYSIZE(channels); ++i) {
+			_seed = 0x5678;
+			Audio::SeekableAudioStream *whole = createStream(Audio::kADPCMMSIma, 5000, channels[i], 512, 700);
+			_seed = 0x5678;
+			Audio::SeekableAudioStream *partial = createStream(Audio::kADPCMMSIma, 5000, channels[i], 512, 700);
+
+			int16 wholeBuffer[16], partialBuffer[10];
+			int wholeSamples = 0, partialSamples = 0;
+			uint32 wholeHash = kFnvHashInit, partialHash = kFnvHashInit;
+			int samples;
+
+			while ((samples = whole->readBuffer(wholeBuffer, 8 * channels[i])) > 0) {
+				for (int j = 0; j < samples; ++j)
+					wholeHash = fnvHash(wholeHash, (uint16)wholeBuffer[j]);
+				wholeSamples += samples;
+			}
+			while ((samples = partial->readBuffer(partialBuffer, readSizes[i])) > 0) {
+				for (int j = 0; j < samples; ++j)
+					partialHash = fnvHash(partialHash, (uint16)partialBuffer[j]);
+				partialSamples += samples;
+			}
+
+			TS_ASSERT(wholeSamples % readSizes[i] != 0);
+			TS_ASSERT_EQUALS(partialSamples, wholeSamples);
+			TS_ASSERT_EQUALS(partialHash, wholeHash);
+			TS_ASSERT(partial->endOfData());
+
+			delete whole;
+			delete partial;
+		}
+	}
+
+	void test_ms() {
+		_seed = 0x2345;
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMS, 3000, 1, 256, false), 3105054283u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMS, 100000, 2, 1024, false), 4192032039u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMS, 70001, 1, 512, true), 732808237u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMS, 70000, 2, 512, false, 1003), 2746168481u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMMS, 70000, 2, 512, false, 512 * 3), 1379954118u);
+	}
+
+	void test_dk3() {
+		_seed = 0x3456;
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMDK3, 3000, 2, 1024, false), 2038891275u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMDK3, 100000, 2, 1024, false), 3385354747u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMDK3, 70001, 2, 4096, true), 3871381877u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMDK3, 70000, 2, 1024, false, 1003), 3525186413u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMDK3, 70000, 2, 1024, false, 1024 * 3), 1551763233u);
+	}
+
+	void test_other_types() {
+		_seed = 0x4567;
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMOki, 3000, 1, 0, false), 1311606885u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMDVI, 3001, 2, 0, true), 1144632841u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMApple, 3400, 2, 34, false), 4093851438u);
+		TS_ASSERT_EQUALS(decode(Audio::kADPCMApple, 68000, 2, 34, true), 173027577u);
+	}
+};
@@ -205,4 +205,44 @@ public:
 	void test_sub_looping_audio_stream_stereo_22050_end_fixed_iter() {
 		testSubLoopingAudioStreamFixedIter(22050, true, 2, 2);
 	}
+
+	void test_lockfree_queuing_audio_stream() {
+		// Small segments, so that the queue links and recycles many of them
+		Audio::QueuingAudioStream *stream = Audio::makeLockFreeQueuingAudioStream(11025, false, 3);
+		const int bufferSamples = 5;
+		int16 buffer[16];
+		int16 queued = 0, expected = 0;
+
+		for (int step = 0; step < 40; ++step) {
+			// Queue a varying number of buffers, each holding its own values
+			for (int i = 0; i < step % 7; ++i) {
+				int16 *data = (int16 *)malloc(bufferSamples * sizeof(int16));
+				for (int j = 0; j < bufferSamples; ++j)
+					data[j] = queued++;
+				stream->queueBuffer((byte *)data, bufferSamples * sizeof(int16), DisposeAfterUse::YES, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+			}
+			TS_ASSERT_EQUALS(stream->numQueuedStreams(), (uint32)((queued - expected + bufferSamples - 1) / bufferSamples));
+
+			const int samples = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+			TS_ASSERT_EQUALS(samples, MIN<int>(ARRAYSIZE(buffer), queued - expected));
+			for (int j = 0; j < samples; ++j)
+				TS_ASSERT_EQUALS(buffer[j], expected++);
+		}
+
+		TS_ASSERT(!stream->endOfStream());
+		stream->finish();
+		TS_ASSERT(!stream->endOfStream());
+
+		while (expected < queued) {
+			const int samples = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+			TS_ASSERT(samples > 0);
+			for (int j = 0; j < samples; ++j)
+				TS_ASSERT_EQUALS(buffer[j], expected++);
+		}
+		TS_ASSERT(stream->endOfData());
+		TS_ASSERT(stream->endOfStream());
+		TS_ASSERT_EQUALS(stream->numQueuedStreams(), 0u);
+
+		delete stream;
+	}
 };
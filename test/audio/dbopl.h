@@ -0,0 +1,108 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/dbopl.h"
+
+#include "helper.h"
+
+#ifndef DISABLE_DOSBOX_OPL
+
+// Renders the DOSBox OPL core with a fixed register stream. The checksums
+// were recorded with the core as it is, so changes to the block renderers
+// have to keep the output exactly the same.
+class DbOplTestSuite : public CxxTest::TestSuite
+{
+private:
+	uint32 _seed;
+
+	void writeRandomRegisters(OPL::DOSBox::DBOPL::Chip &chip, bool opl3, int count) {
+		for (int i = 0; i < count; ++i) {
+			uint32 bank = (opl3 && (nextRandom(_seed) & 1)) ? 0x100 : 0;
+			uint32 reg;
+			uint8 val = nextRandom(_seed) & 0xff;
+
+			switch (nextRandom(_seed) % 8) {
+			case 0:
+				reg = 0x20 + nextRandom(_seed) % 0x16;
+				break;
+			case 1:
+				// Keep operators audible most of the time
+				reg = 0x40 + nextRandom(_seed) % 0x16;
+				val &= 0xcf;
+				break;
+			case 2:
+				reg = 0x60 + nextRandom(_seed) % 0x16;
+				break;
+			case 3:
+				reg = 0x80 + nextRandom(_seed) % 0x16;
+				break;
+			case 4:
+				reg = 0xa0 + nextRandom(_seed) % 9;
+				break;
+			case 5:
+				reg = 0xb0 + nextRandom(_seed) % 9;
+				break;
+			case 6:
+				reg = 0xc0 + nextRandom(_seed) % 9;
+				val |= 0x30;
+				break;
+			default:
+				reg = 0xe0 + nextRandom(_seed) % 0x16;
+				break;
+			}
+
+			chip.WriteReg(bank | reg, val);
+		}
+	}
+
+	uint32 renderStream(bool opl3, bool percussion) {
+		const uint32 rate = 22050;
+		const int blocks = 200;
+		const int channels = opl3 ? 2 : 1;
+
+		OPL::DOSBox::DBOPL::InitTables();
+		OPL::DOSBox::DBOPL::Chip chip;
+		chip.Setup(rate);
+
+		_seed = opl3 ? 0x1234 : (percussion ? 0x5678 : 0x9abc);
+
+		chip.WriteReg(0x01, 0x20);
+		if (opl3) {
+			chip.WriteReg(0x105, 0x01);
+			chip.WriteReg(0x104, 0x3f);
+		}
+
+		int32 buffer[512 * 2];
+		uint32 hash = kFnvHashInit;
+		for (int block = 0; block < blocks; ++block) {
+			writeRandomRegisters(chip, opl3, 12);
+			if (percussion)
+				chip.WriteReg(0xbd, 0x20 | (nextRandom(_seed) & 0xdf));
+
+			uint32 samples = 64 + nextRandom(_seed) % 449;
+			if (opl3)
+				chip.GenerateBlock3(samples, buffer);
+			else
+				chip.GenerateBlock2(samples, buffer);
+
+			for (uint32 i = 0; i < samples * channels; ++i) {
+				hash = fnvHash(hash, (uint32)buffer[i]);
+			}
+		}
+		return hash;
+	}
+
+public:
+	void test_opl2_melodic() {
+		TS_ASSERT_EQUALS(renderStream(false, false), 3075888461u);
+	}
+
+	void test_opl2_percussion() {
+		TS_ASSERT_EQUALS(renderStream(false, true), 1783751563u);
+	}
+
+	void test_opl3_four_op() {
+		TS_ASSERT_EQUALS(renderStream(true, false), 4147141791u);
+	}
+};
+
+#endif
@@ -9,6 +9,26 @@
 #include <math.h>
 #include <limits>
 
+/**
+ * Linear congruential generator, for test input which has to be the same
+ * on every run and platform.
+ */
+static inline uint32 nextRandom(uint32 &seed) {
+	seed = seed * 1103515245 + 12345;
+	return (seed >> 16) & 0x7fff;
+}
+
+/** Initial value of an FNV-1a hash. */
+static const uint32 kFnvHashInit = 2166136261u;
+
+/**
+ * Folds a value into an FNV-1a hash, to compare generated output against
+ * a checksum recorded earlier.
+ */
+static inline uint32 fnvHash(uint32 hash, uint32 value) {
+	return (hash ^ value) * 16777619u;
+}
+
 template<typename T>
 static T *createSine(const int sampleRate, const int time) {
 	T *sine = (T *)malloc(sizeof(T) * time * sampleRate);
@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mididrv.h"
+#include "audio/midiparser.h"
+
+#include "common/array.h"
+
+// Jumps which do not fire events may start from the seek index built at load
+// time, while jumps which fire events always parse the track from the start.
+// Both must leave the parser in the same state, which is checked by comparing
+// what is played afterwards.
+class MidiParserTestSuite : public CxxTest::TestSuite
+{
+private:
+	class RecordingDriver : public MidiDriver_BASE {
+	public:
+		Common::Array<uint32> _log;
+
+		void send(uint32 b) { sendDelayed(b, 0); }
+		void sendDelayed(uint32 b, uint32 delay) {
+			_log.push_back(b);
+			_log.push_back(delay);
+		}
+		void metaEvent(byte type, byte *data, uint16 length) {
+			_log.push_back(0xFF00 | type);
+		}
+	};
+
+	Common::Array<byte> _song;
+
+	void writeVLQ(Common::Array<byte> &track, uint32 value) {
+		if (value >= 0x80)
+			track.push_back(0x80 | (value >> 7));
+		track.push_back(value & 0x7F);
+	}
+
+	void createSong() {
+		Common::Array<byte> track;
+		for (int i = 0; i < 400; ++i) {
+			if (i % 50 == 25) {
+				const uint32 tempo = 300000 + i * 1000;
+				writeVLQ(track, i % 5);
+				track.push_back(0xFF);
+				track.push_back(0x51);
+				track.push_back(3);
+				track.push_back(tempo >> 16);
+				track.push_back((tempo >> 8) & 0xFF);
+				track.push_back(tempo & 0xFF);
+			}
+
+			writeVLQ(track, (i * 7) % 23 + 1);
+			track.push_back(0x90 | (i % 16));
+			track.push_back(40 + i % 40);
+			track.push_back(100);
+
+			// Note off using running status
+			writeVLQ(track, (i * 11) % 150);
+			track.push_back(40 + i % 40);
+			track.push_back(0);
+		}
+		writeVLQ(track, 10);
+		track.push_back(0xFF);
+		track.push_back(0x2F);
+		track.push_back(0);
+
+		static const byte header[] = {
+			'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96,
+			'M', 'T', 'r', 'k'
+		};
+		_song.clear();
+		for (int i = 0; i < ARRAYSIZE(header); ++i)
+			_song.push_back(header[i]);
+		_song.push_back(track.size() >> 24);
+		_song.push_back((track.size() >> 16) & 0xFF);
+		_song.push_back((track.size() >> 8) & 0xFF);
+		_song.push_back(track.size() & 0xFF);
+		for (uint i = 0; i < track.size(); ++i)
+			_song.push_back(track[i]);
+	}
+
+	void playAfterJump(uint32 tick, bool fireEvents, RecordingDriver &driver, uint32 &endTick) {
+		MidiParser *parser = MidiParser::createParser_SMF();
+		parser->setMidiDriver(&driver);
+		parser->setTimerRate(4000);
+		TS_ASSERT(parser->loadMusic(&_song[0], _song.size()));
+
+		// Start from another tempo, the index has to adapt to it
+		parser->setTempo(400000);
+		TS_ASSERT(parser->jumpToTick(tick, fireEvents));
+		TS_ASSERT_EQUALS(parser->getTick(), tick);
+
+		driver._log.clear();
+		for (int i = 0; i < 300; ++i)
+			parser->onTimer();
+		endTick = parser->getTick();
+
+		parser->unloadMusic();
+		delete parser;
+	}
+
+public:
+	void test_jump_with_seek_index() {
+		createSong();
+
+		static const uint32 ticks[] = { 1, 31, 500, 2000, 4321, 9000, 15000 };
+		for (int i = 0; i < ARRAYSIZE(ticks); ++i) {
+			RecordingDriver indexed, scanned;
+			uint32 indexedEndTick, scannedEndTick;
+			playAfterJump(ticks[i], false, indexed, indexedEndTick);
+			playAfterJump(ticks[i], true, scanned, scannedEndTick);
+
+			TS_ASSERT(!indexed._log.empty());
+			TS_ASSERT(indexed._log == scanned._log);
+			TS_ASSERT_EQUALS(indexedEndTick, scannedEndTick);
+		}
+	}
+};
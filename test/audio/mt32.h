@@ -0,0 +1,137 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+
+#ifdef USE_MT32EMU
+
+#include "audio/softsynth/mt32/mt32emu.h"
+#include "audio/softsynth/mt32/BReverbModel.h"
+#include "audio/softsynth/mt32/LA32WaveGenerator.h"
+
+#include "helper.h"
+
+// The LA32 wave generator and the BOSS reverb model are fed with fixed
+// parameters and input, and their output must match checksums recorded
+// with the integer implementation.
+class MT32EmuTestSuite : public CxxTest::TestSuite
+{
+private:
+	uint32 _seed;
+
+	uint32 hashSample(uint32 hash, MT32Emu::Sample sample) {
+		return fnvHash(hash, (uint16)sample);
+	}
+
+	uint32 renderSynthPair(bool ringModulated, bool mixed, bool sawtooth) {
+		MT32Emu::LA32PartialPair partialPair;
+		partialPair.init(ringModulated, mixed);
+		partialPair.initSynth(MT32Emu::LA32PartialPair::MASTER, sawtooth, 64 + nextRandom(_seed) % 192, 1 + nextRandom(_seed) % 31);
+		partialPair.initSynth(MT32Emu::LA32PartialPair::SLAVE, !sawtooth, nextRandom(_seed) % 256, 1 + nextRandom(_seed) % 31);
+
+		uint32 hash = kFnvHashInit;
+		for (int block = 0; block < 64; ++block) {
+			// Parameters are kept for a block as the ramps in Partial would
+			const uint32 masterAmp = (nextRandom(_seed) << 7) & 0x3fffff;
+			const uint16 masterPitch = 0x6000 + nextRandom(_seed) % 0x7000;
+			const uint32 masterCutoff = (78 << 18) + (nextRandom(_seed) << 12) % (162 << 18);
+			const uint32 slaveAmp = (nextRandom(_seed) << 7) & 0x3fffff;
+			const uint16 slavePitch = 0x6000 + nextRandom(_seed) % 0x7000;
+			const uint32 slaveCutoff = (78 << 18) + (nextRandom(_seed) << 12) % (162 << 18);
+
+			for (int i = 0; i < 256; ++i) {
+				partialPair.generateNextSample(MT32Emu::LA32PartialPair::MASTER, masterAmp, masterPitch, masterCutoff + (i << 10));
+				partialPair.generateNextSample(MT32Emu::LA32PartialPair::SLAVE, slaveAmp, slavePitch, slaveCutoff);
+				hash = hashSample(hash, partialPair.nextOutSample());
+			}
+		}
+		return hash;
+	}
+
+	uint32 renderPCMPair(bool looped) {
+		MT32Emu::Bit16s wave[1000];
+		for (int i = 0; i < ARRAYSIZE(wave); ++i)
+			wave[i] = (MT32Emu::Bit16s)(nextRandom(_seed) * 2 - 0x7fff);
+
+		MT32Emu::LA32PartialPair partialPair;
+		partialPair.init(false, false);
+		partialPair.initPCM(MT32Emu::LA32PartialPair::MASTER, wave, ARRAYSIZE(wave), looped);
+
+		uint32 hash = kFnvHashInit;
+		for (int block = 0; block < 32; ++block) {
+			const uint32 amp = (nextRandom(_seed) << 7) & 0x3fffff;
+			const uint16 pitch = 0x8000 + nextRandom(_seed) % 0x6000;
+			for (int i = 0; i < 256; ++i) {
+				partialPair.generateNextSample(MT32Emu::LA32PartialPair::MASTER, amp, pitch, 0);
+				hash = hashSample(hash, partialPair.nextOutSample());
+			}
+		}
+		return hash;
+	}
+
+	uint32 renderReverb(MT32Emu::ReverbMode mode, bool mt32CompatibleModel) {
+		MT32Emu::BReverbModel reverb(mode, mt32CompatibleModel);
+		reverb.open();
+
+		MT32Emu::Sample inLeft[512], inRight[512], outLeft[512], outRight[512];
+		uint32 hash = kFnvHashInit;
+		for (int block = 0; block < 48; ++block) {
+			reverb.setParameters(nextRandom(_seed) % 8, 1 + nextRandom(_seed) % 7);
+
+			// Feed silence now and then to exercise the reverb tail
+			const bool silent = (block % 4) == 3;
+			for (int i = 0; i < ARRAYSIZE(inLeft); ++i) {
+				inLeft[i] = silent ? 0 : (MT32Emu::Sample)(nextRandom(_seed) * 2 - 0x7fff);
+				inRight[i] = silent ? 0 : (MT32Emu::Sample)(nextRandom(_seed) * 2 - 0x7fff);
+			}
+
+			reverb.process(inLeft, inRight, outLeft, outRight, ARRAYSIZE(inLeft));
+			for (int i = 0; i < ARRAYSIZE(outLeft); ++i) {
+				hash = hashSample(hash, outLeft[i]);
+				hash = hashSample(hash, outRight[i]);
+			}
+		}
+		reverb.close();
+		return hash;
+	}
+
+public:
+	void test_la32_synth_mixed() {
+		_seed = 0x1234;
+		TS_ASSERT_EQUALS(renderSynthPair(false, false, false), 2236484614u);
+	}
+
+	void test_la32_synth_sawtooth() {
+		_seed = 0x2345;
+		TS_ASSERT_EQUALS(renderSynthPair(false, false, true), 2827250699u);
+	}
+
+	void test_la32_synth_ring_modulated() {
+		_seed = 0x3456;
+		TS_ASSERT_EQUALS(renderSynthPair(true, false, false), 604108563u);
+		TS_ASSERT_EQUALS(renderSynthPair(true, true, true), 1601525436u);
+	}
+
+	void test_la32_pcm() {
+		_seed = 0x4567;
+		TS_ASSERT_EQUALS(renderPCMPair(true), 1407017008u);
+		TS_ASSERT_EQUALS(renderPCMPair(false), 1283435191u);
+	}
+
+	void test_reverb_cm32l() {
+		_seed = 0x5678;
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_ROOM, false), 1013060286u);
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_HALL, false), 350997153u);
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_PLATE, false), 2120348540u);
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_TAP_DELAY, false), 3376323295u);
+	}
+
+	void test_reverb_mt32() {
+		_seed = 0x6789;
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_ROOM, true), 954529258u);
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_HALL, true), 3387745227u);
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_PLATE, true), 1351794108u);
+		TS_ASSERT_EQUALS(renderReverb(MT32Emu::REVERB_MODE_TAP_DELAY, true), 44190099u);
+	}
+};
+
+#endif
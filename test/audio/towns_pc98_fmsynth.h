@@ -0,0 +1,197 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "audio/softsynth/fmtowns_pc98/towns_pc98_fmsynth.h"
+
+#include "common/list.h"
+#include "common/system.h"
+
+#include "graphics/pixelformat.h"
+
+#include "helper.h"
+
+/**
+ * OSystem which does nothing. The synth and the mixer create mutexes
+ * through g_system, which the test runner does not set up otherwise.
+ * Everything runs on one thread, so the mutexes do not need to lock.
+ */
+class TownsPC98TestSystem : public OSystem {
+public:
+	virtual const GraphicsMode *getSupportedGraphicsModes() const {
+		static const GraphicsMode noGraphicsModes[] = { { 0, 0, 0 } };
+		return noGraphicsModes;
+	}
+	virtual int getDefaultGraphicsMode() const { return 0; }
+	virtual bool setGraphicsMode(int mode) { return true; }
+	virtual int getGraphicsMode() const { return 0; }
+	virtual Graphics::PixelFormat getScreenFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	virtual Common::List<Graphics::PixelFormat> getSupportedFormats() const { return Common::List<Graphics::PixelFormat>(); }
+	virtual void initSize(uint width, uint height, const Graphics::PixelFormat *format) {}
+	virtual int16 getHeight() { return 0; }
+	virtual int16 getWidth() { return 0; }
+	virtual PaletteManager *getPaletteManager() { return 0; }
+	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual Graphics::Surface *lockScreen() { return 0; }
+	virtual void unlockScreen() {}
+	virtual void fillScreen(uint32 col) {}
+	virtual void updateScreen() {}
+	virtual void setShakePos(int shakeOffset) {}
+	virtual void showOverlay() {}
+	virtual void hideOverlay() {}
+	virtual Graphics::PixelFormat getOverlayFormat() const { return Graphics::PixelFormat::createFormatCLUT8(); }
+	virtual void clearOverlay() {}
+	virtual void grabOverlay(void *buf, int pitch) {}
+	virtual void copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {}
+	virtual int16 getOverlayHeight() { return 0; }
+	virtual int16 getOverlayWidth() { return 0; }
+	virtual bool showMouse(bool visible) { return false; }
+	virtual void warpMouse(int x, int y) {}
+	virtual void setMouseCursor(const void *buf, uint w, uint h, int hotspotX, int hotspotY, uint32 keycolor, bool dontScale, const Graphics::PixelFormat *format) {}
+	virtual uint32 getMillis(bool skipRecord) { return 0; }
+	virtual void delayMillis(uint msecs) {}
+	virtual void getTimeAndDate(TimeDate &t) const { memset(&t, 0, sizeof(t)); }
+	virtual MutexRef createMutex() { return 0; }
+	virtual void lockMutex(MutexRef mutex) {}
+	virtual void unlockMutex(MutexRef mutex) {}
+	virtual void deleteMutex(MutexRef mutex) {}
+	virtual Audio::Mixer *getMixer() { return 0; }
+	virtual void quit() {}
+	virtual void displayMessageOnOSD(const char *msg) {}
+	virtual void logMessage(LogMessageType::Type type, const char *message) {}
+};
+
+/**
+ * Synth which writes pseudo-random registers from its timer A callback,
+ * in the way the Towns and PC-98 drivers update the chip on each tick.
+ */
+class TownsPC98TestSynth : public TownsPC98_FmSynth {
+public:
+	TownsPC98TestSynth(Audio::Mixer *mixer, EmuType type, uint32 &seed) : TownsPC98_FmSynth(mixer, type), _seed(seed) {}
+
+	void setVolume(int volA, int volB, int channelMaskA, int channelMaskB) {
+		setVolumeIntern(volA, volB);
+		setVolumeChannelMasks(channelMaskA, channelMaskB);
+	}
+
+protected:
+	void timerCallbackA() {
+		const int numWrites = nextRandom(_seed) % 6;
+		for (int i = 0; i < numWrites; ++i) {
+			const uint8 part = (_numChan == 6) ? (nextRandom(_seed) & 1) : 0;
+			const uint8 chan = nextRandom(_seed) % 3;
+
+			switch (nextRandom(_seed) % 8) {
+			case 0:
+				// Algorithm, feedback and panning
+				writeReg(part, 0xb0 + chan, nextRandom(_seed) & 0x3f);
+				writeReg(part, 0xb4 + chan, 0xc0 & (nextRandom(_seed) | 0x40));
+				break;
+			case 1:
+			case 2:
+				// Operator parameters
+				for (int op = 0; op < 4; ++op) {
+					const uint8 reg = chan + op * 4;
+					writeReg(part, 0x30 + reg, nextRandom(_seed) & 0x7f);
+					writeReg(part, 0x40 + reg, nextRandom(_seed) % 60);
+					writeReg(part, 0x50 + reg, nextRandom(_seed) & 0xdf);
+					writeReg(part, 0x60 + reg, nextRandom(_seed) & 0x1f);
+					writeReg(part, 0x70 + reg, nextRandom(_seed) & 0x1f);
+					writeReg(part, 0x80 + reg, nextRandom(_seed) & 0xff);
+				}
+				break;
+			case 3:
+			case 4:
+				// Frequency and key on
+				writeReg(part, 0xa4 + chan, nextRandom(_seed) & 0x3f);
+				writeReg(part, 0xa0 + chan, nextRandom(_seed) & 0xff);
+				writeReg(0, 0x28, (nextRandom(_seed) & 0xf0) | chan | (part << 2));
+				break;
+			case 5:
+				// Key off
+				writeReg(0, 0x28, chan | (part << 2));
+				break;
+			case 6:
+				// SSG tone, noise, mixer and levels
+				writeReg(0, nextRandom(_seed) % 11, nextRandom(_seed) & 0xff);
+				writeReg(0, 7, nextRandom(_seed) & 0x3f);
+				break;
+			case 7:
+				// Rhythm levels, key on and key off
+				writeReg(0, 0x18 + nextRandom(_seed) % 6, nextRandom(_seed) & 0xdf);
+				writeReg(0, 0x10, (nextRandom(_seed) & 0x80) | (nextRandom(_seed) & 0x3f));
+				break;
+			}
+		}
+	}
+
+	void timerCallbackB() {}
+
+private:
+	uint32 &_seed;
+};
+
+// The FM, SSG and rhythm sections of all three chip types are driven with
+// fixed register writes, and their output must match checksums recorded
+// with the per sample renderer.
+class TownsPC98FmSynthTestSuite : public CxxTest::TestSuite
+{
+private:
+	uint32 _seed;
+	OSystem *_oldSystem;
+	TownsPC98TestSystem _system;
+
+	uint32 render(TownsPC98_FmSynth::EmuType type, uint sampleRate) {
+		Audio::MixerImpl mixer(&_system, sampleRate);
+		mixer.setReady(true);
+
+		TownsPC98TestSynth synth(&mixer, type, _seed);
+		synth.init();
+
+		// Run timer A with a short period and timer B alongside it
+		synth.writeReg(0, 0x24, 0xf0);
+		synth.writeReg(0, 0x26, 0xe0);
+		synth.writeReg(0, 0x27, 0x03);
+
+		int16 buffer[1024];
+		uint32 hash = kFnvHashInit;
+		for (int block = 0; block < 100; ++block) {
+			if (block % 25 == 10)
+				synth.setVolume(nextRandom(_seed) % 256, nextRandom(_seed) % 256, nextRandom(_seed) & 0x3ff, nextRandom(_seed) & 0x3ff);
+
+			// Stereo, so always an even number of samples
+			const int numSamples = ((nextRandom(_seed) % ARRAYSIZE(buffer)) + 2) & ~1;
+			synth.readBuffer(buffer, numSamples);
+			for (int i = 0; i < numSamples; ++i)
+				hash = fnvHash(hash, (uint16)buffer[i]);
+		}
+		return hash;
+	}
+
+public:
+	void setUp() {
+		_oldSystem = g_system;
+		g_system = &_system;
+	}
+
+	void tearDown() {
+		g_system = _oldSystem;
+	}
+
+	void test_towns() {
+		_seed = 0x1234;
+		TS_ASSERT_EQUALS(render(TownsPC98_FmSynth::kTypeTowns, 44100), 4189489218u);
+		TS_ASSERT_EQUALS(render(TownsPC98_FmSynth::kTypeTowns, 22050), 827184161u);
+	}
+
+	void test_pc98_26() {
+		_seed = 0x2345;
+		TS_ASSERT_EQUALS(render(TownsPC98_FmSynth::kType26, 44100), 3235889324u);
+		TS_ASSERT_EQUALS(render(TownsPC98_FmSynth::kType26, 22050), 2625165638u);
+	}
+
+	void test_pc98_86() {
+		_seed = 0x3456;
+		TS_ASSERT_EQUALS(render(TownsPC98_FmSynth::kType86, 44100), 1183745892u);
+		TS_ASSERT_EQUALS(render(TownsPC98_FmSynth::kType86, 22050), 4172163837u);
+	}
+};